@@ -17,4 +17,19 @@ enum class ActFunc : unsigned
     Count, // The number of activation functions available.
 };
 
+/*******************************************************************************
+ * @brief Enum representing the accuracy tiers available for the hyperbolic 
+ *        tangent. The approximations are rational functions evaluated with 
+ *        SIMD instructions, clamped to the range where they reach +-1, and 
+ *        never exceed 1 in magnitude. The maximum absolute errors compared to
+ *        std::tanh have been measured over [-20, 20] for both float and double.
+ ******************************************************************************/
+enum class TanhPrecision : unsigned
+{
+    Exact, // std::tanh from the standard library.
+    High,  // Minimax rational [13/6] approximation, max absolute error 4e-7.
+    Low,   // Lambert continued fraction [7/6], max absolute error 1e-4.
+    Count, // The number of accuracy tiers available.
+};
+
 } // namespace ml
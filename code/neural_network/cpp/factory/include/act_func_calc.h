@@ -4,6 +4,8 @@
  ******************************************************************************/
 #pragma once
 
+#include <cstddef>
+
 #include "act_func.h"
 
 namespace ml
@@ -13,7 +15,10 @@ namespace ml
  * @brief Class implementation of activation function calculator.
  * 
  *        This class is non-copyable and non-movable.
+ * 
+ * @tparam T The floating-point type of the calculations (default = double).
  ******************************************************************************/
+template <typename T = double>
 class ActFuncCalc
 {
 public:
@@ -21,9 +26,13 @@ public:
     /*******************************************************************************
      * @brief Creates new activation function calculator.
      * 
-     * @param actFunc The type of activation function to use for the calculations.
+     * @param actFunc       The type of activation function to use for the 
+     *                      calculations.
+     * @param tanhPrecision The accuracy of the hyperbolic tangent, which is only
+     *                      used if actFunc is ActFunc::Tanh (default = exact).
      ******************************************************************************/
-    ActFuncCalc(const ActFunc actFunc);
+    ActFuncCalc(const ActFunc actFunc, 
+                const TanhPrecision tanhPrecision = TanhPrecision::Exact);
 
     /*******************************************************************************
      * @brief Deletes activation function calculator.
@@ -37,6 +46,14 @@ public:
      *         an enum of enum class ActFun.
      ******************************************************************************/
     ActFunc actFunc() const;
+
+    /*******************************************************************************
+     * @brief Provides the accuracy of the hyperbolic tangent.
+     * 
+     * @return The accuracy of the hyperbolic tangent represented as an enum of 
+     *         enum class TanhPrecision.
+     ******************************************************************************/
+    TanhPrecision tanhPrecision() const;
     
     /*******************************************************************************
      * @brief Provides the activation function output for a given input.
@@ -44,19 +61,62 @@ public:
      * @param number The number for which to calculate the activation function 
      *               output.
      *
-     * @return The activation function output as a double.
+     * @return The activation function output.
+     ******************************************************************************/
+    T output(const T number) const;
+
+    /*******************************************************************************
+     * @brief Provides the activation function gradient expressed from the 
+     *        activation function output, i.e. the stored output of a node. 
+     *        Hence no transcendental functions are evaluated; the gradient of 
+     *        tanh is calculated as 1 - y^2.
+     *
+     * @param number The activation function output for which to calculate the 
+     *               activation function gradient.
+     *
+     * @return The activation function gradient.
      ******************************************************************************/
-    double output(const double number) const;
+    T gradient(const T number) const;
 
     /*******************************************************************************
-     * @brief Provides the activation function gradient for a given input.
+     * @brief Applies the activation function to an entire buffer. The activation
+     *        function is selected once per call rather than once per element,
+     *        and ReLU as well as approximated tanh are computed with SIMD 
+     *        instructions.
      *
-     * @param number The number for which to calculate the activation 
-     *               function gradient.
+     * @param input  Pointer to the numbers for which to calculate the activation
+     *               function output.
+     * @param output Pointer to the buffer in which to store the output. 
+     *               May be the same as input.
+     * @param size   The number of elements in each buffer.
+     ******************************************************************************/
+    void output(const T* input, T* output, const std::size_t size) const;
+
+    /*******************************************************************************
+     * @brief Multiplies each element of a buffer with the activation function 
+     *        gradient of the corresponding number, i.e. error[i] *= 
+     *        gradient(number[i]). The activation function is selected once per 
+     *        call rather than once per element.
+     *
+     * @param number Pointer to the activation function outputs for which to 
+     *               calculate the activation function gradient.
+     * @param error  Pointer to the buffer to multiply with the gradients.
+     * @param size   The number of elements in each buffer.
+     ******************************************************************************/
+    void multiplyGradient(const T* number, T* error, const std::size_t size) const;
+
+    /*******************************************************************************
+     * @brief Calculates the activation function gradient for an entire buffer, 
+     *        i.e. gradient[i] = gradient(number[i]). The activation function is 
+     *        selected once per call rather than once per element.
      *
-     * @return The activation function gradient as a double.
+     * @param number   Pointer to the activation function outputs for which to 
+     *                 calculate the activation function gradient.
+     * @param gradient Pointer to the buffer in which to store the gradients.
+     *                 Must not overlap the activation function outputs.
+     * @param size     The number of elements in each buffer.
      ******************************************************************************/
-    double gradient(const double number) const;
+    void gradient(const T* number, T* gradient, const std::size_t size) const;
 
     /*******************************************************************************
      * @brief Provides the name of the activation function used for the calculations
@@ -73,7 +133,8 @@ public:
     ActFuncCalc& operator=(ActFuncCalc&&)      = delete; // No move assignment.
 
 private:
-    ActFunc myActFunc; // Activation function used.
+    ActFunc myActFunc;             // Activation function used.
+    TanhPrecision myTanhPrecision; // Accuracy of the hyperbolic tangent.
 };
 
 } // namespace ml
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * @brief Implementation of allocator for aligned memory blocks.
+ ******************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace ml
+{
+
+/*******************************************************************************
+ * @brief Allocator providing memory blocks aligned to specified boundary,
+ *        which enables aligned SIMD loads and stores.
+ *
+ * @tparam T         The type of the elements to allocate.
+ * @tparam Alignment The alignment in bytes (default = 64, i.e. one cache line).
+ ******************************************************************************/
+template <typename T, std::size_t Alignment = 64U>
+struct AlignedAllocator
+{
+    static_assert((Alignment & (Alignment - 1U)) == 0U,
+        "The alignment must be a power of two!");
+    static_assert(Alignment >= alignof(T),
+        "The alignment cannot be smaller than the alignment of the element type!");
+
+    using value_type = T; // The type of the allocated elements.
+
+    /*******************************************************************************
+     * @brief Rebinds the allocator to another element type.
+     *
+     * @tparam U The new element type.
+     ******************************************************************************/
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>; // Allocator for type U.
+    };
+
+    /*******************************************************************************
+     * @brief Creates new aligned allocator.
+     ******************************************************************************/
+    AlignedAllocator() noexcept = default;
+
+    /*******************************************************************************
+     * @brief Creates new aligned allocator from allocator of another type.
+     ******************************************************************************/
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    /*******************************************************************************
+     * @brief Allocates aligned memory block.
+     *
+     * @param size The number of elements to allocate memory for.
+     *
+     * @return Pointer to the allocated memory block.
+     ******************************************************************************/
+    T* allocate(const std::size_t size)
+    {
+        return static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    /*******************************************************************************
+     * @brief Deallocates aligned memory block.
+     *
+     * @param data Pointer to the memory block to deallocate.
+     ******************************************************************************/
+    void deallocate(T* data, const std::size_t) noexcept
+    {
+        ::operator delete(data, std::align_val_t{Alignment});
+    }
+};
+
+// -----------------------------------------------------------------------------
+template <typename T, typename U, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&)
+{
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T, typename U, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&)
+{
+    return false;
+}
+
+} // namespace ml
@@ -0,0 +1,20 @@
+/*******************************************************************************
+ * @brief Implementation of file formats for training data.
+ ******************************************************************************/
+#pragma once
+
+namespace ml
+{
+
+/*******************************************************************************
+ * @brief Enum representing the different file formats available for streamed
+ *        training data.
+ ******************************************************************************/
+enum class DatasetFormat : unsigned
+{
+    Csv,    // One training set per line: input values followed by reference values.
+    Binary, // Consecutive records of input values followed by reference values.
+    Count,  // The number of dataset formats available.
+};
+
+} // namespace ml
@@ -9,6 +9,7 @@
 
 #include "act_func_calc.h"
 #include "dense_layer_interface.h"
+#include "matrix.h"
 
 namespace ml
 {
@@ -16,21 +17,44 @@ namespace ml
 /*******************************************************************************
  * @brief Class implementation of dense layers.
  * 
- *        This class is non-copyable and non-movable.
+ *        This class is non-copyable and non-movable. Explicit instantiations
+ *        are provided for float and double.
+ * 
+ * @tparam T The floating-point type of the parameters (default = double).
  ******************************************************************************/
-class DenseLayer : public DenseLayerInterface
+template <typename T = double>
+class DenseLayer : public DenseLayerInterface<T>
 {
 public:
 
     /*******************************************************************************
      * @brief Creates new dense layer.
      *
-     * @param nodeCount   The number of nodes in the new layer.
-     * @param weightCount The number of weights per node in the new layer.
-     * @param actFunc     The activation function of the layer (default = ReLU).
+     * @param nodeCount     The number of nodes in the new layer.
+     * @param weightCount   The number of weights per node in the new layer.
+     * @param actFunc       The activation function of the layer (default = ReLU).
+     * @param tanhPrecision The accuracy of the hyperbolic tangent, which is only
+     *                      used if actFunc is ActFunc::Tanh (default = exact).
      ******************************************************************************/
     DenseLayer(const std::size_t nodeCount, const std::size_t weightCount, 
-               const ActFunc actFunc = ActFunc::Relu);
+               const ActFunc actFunc = ActFunc::Relu,
+               const TanhPrecision tanhPrecision = TanhPrecision::Exact);
+
+    /*******************************************************************************
+     * @brief Creates new dense layer with given parameters, for instance
+     *        parameters loaded from a model file.
+     *
+     * @param bias          The bias of each node.
+     * @param weights       The weights of each node (one row per node). A view 
+     *                      is used without copying the viewed memory, which 
+     *                      must then outlive the layer.
+     * @param actFunc       The activation function of the layer (default = ReLU).
+     * @param tanhPrecision The accuracy of the hyperbolic tangent, which is only
+     *                      used if actFunc is ActFunc::Tanh (default = exact).
+     ******************************************************************************/
+    DenseLayer(std::vector<T> bias, Matrix<T> weights, 
+               const ActFunc actFunc = ActFunc::Relu,
+               const TanhPrecision tanhPrecision = TanhPrecision::Exact);
 
     /*******************************************************************************
      * @brief Deletes dense layer.
@@ -42,29 +66,29 @@ public:
      *
      * @return Reference to vector holding the output of the dense layer.
      ******************************************************************************/
-    const std::vector<double>& output() const;
+    const std::vector<T>& output() const;
 
     /*******************************************************************************
      * @brief Provides the error of the dense layer.
      *
      * @return Reference to vector holding the error of the dense layer.
      ******************************************************************************/
-    const std::vector<double>& error() const;
+    const std::vector<T>& error() const;
 
     /*******************************************************************************
      * @brief Provides the bias of the dense layer.
      *
      * @return Reference to vector holding the bias of the dense layer.
      ******************************************************************************/
-    const std::vector<double>& bias() const;
+    const std::vector<T>& bias() const;
 
     /*******************************************************************************
      * @brief Provides the weights of the dense layer.
      *
-     * @return Reference to two-dimensional vector holding the weights of 
-     *         the dense layer.
+     * @return Reference to contiguous row-major matrix holding the weights of 
+     *         the dense layer, where each row holds the weights of one node.
      ******************************************************************************/
-    const std::vector<std::vector<double>>& weights() const;
+    const Matrix<T>& weights() const;
 
     /*******************************************************************************
      * @brief Provides the activation function of the dense layer.
@@ -73,6 +97,13 @@ public:
      ******************************************************************************/
     ActFunc actFunc() const;
 
+    /*******************************************************************************
+     * @brief Provides the accuracy of the hyperbolic tangent of the dense layer.
+     * 
+     * @return The accuracy as an enumerator of enum TanhPrecision.
+     ******************************************************************************/
+    TanhPrecision tanhPrecision() const;
+
     /*******************************************************************************
      * @brief Provides the number of nodes in the dense layer.
      * 
@@ -86,13 +117,53 @@ public:
      * @return The number of weights per node as an unsigned integer.
      ******************************************************************************/
     std::size_t weightCount() const;
+
+    /*******************************************************************************
+     * @brief Indicates if the activation function gradient of each node is cached
+     *        during feedforward, so that backpropagation is a pure multiplication.
+     * 
+     * @return True if gradient caching is enabled, else false.
+     ******************************************************************************/
+    bool gradientCaching() const;
+
+    /*******************************************************************************
+     * @brief Enables or disables caching of the activation function gradients.
+     *        Caching is enabled by default for new layers and disabled for 
+     *        layers created from existing parameters, such as loaded models.
+     *        Disabling it releases the cache. The gradients are then calculated
+     *        from the stored output during backpropagation instead.
+     * 
+     * @param enable True to enable gradient caching, false to disable it.
+     ******************************************************************************/
+    void setGradientCaching(const bool enable);
     
     /*******************************************************************************
-     * @brief Performs feedforward for dense layer.
+     * @brief Performs feedforward for dense layer. The gradient cache is not
+     *        filled, see feedforwardForTraining.
+     * 
+     * @param input Reference to vector holding the input of the dense layer.
+     ******************************************************************************/
+    void feedforward(const std::vector<T>& input);
+
+    /*******************************************************************************
+     * @brief Performs feedforward for dense layer ahead of backpropagation. If
+     *        gradient caching is enabled, the activation function gradient of
+     *        each node is cached as well, so that the following backpropagation
+     *        is a pure multiplication.
      * 
      * @param input Reference to vector holding the input of the dense layer.
      ******************************************************************************/
-    void feedforward(const std::vector<double>& input);
+    void feedforwardForTraining(const std::vector<T>& input);
+
+    /*******************************************************************************
+     * @brief Performs feedforward for a single input without modifying the state
+     *        of the dense layer, which makes it safe to call from several threads.
+     * 
+     * @param input  Reference to vector holding the input of the dense layer.
+     * @param output Reference to vector in which to store the output. The vector 
+     *               is resized if needed.
+     ******************************************************************************/
+    void feedforward(const std::vector<T>& input, std::vector<T>& output) const;
 
     /*******************************************************************************
      * @brief Performs backpropagation for output layer.
@@ -101,7 +172,7 @@ public:
      * 
      * @note This method is implemented for output layers only.
      ******************************************************************************/
-    void backpropagate(const std::vector<double>& reference);
+    void backpropagate(const std::vector<T>& reference);
 
     /*******************************************************************************
      * @brief Performs backpropagation for hidden layer.
@@ -110,7 +181,20 @@ public:
      * 
      * @note This method is implemented for hidden layers only.
      ******************************************************************************/
-    void backpropagate(const DenseLayerInterface& nextLayer);
+    void backpropagate(const DenseLayerInterface<T>& nextLayer);
+
+    /*******************************************************************************
+     * @brief Performs backpropagation for hidden layer from the error propagated
+     *        by the next layer, i.e. the errors of the next layer weighted with 
+     *        its weights. This is used in combination with the fused optimization
+     *        of the next layer, see optimize(input, learningRate, inputError).
+     * 
+     * @param propagatedError Reference to vector holding the propagated error, 
+     *                        one value per node.
+     * 
+     * @note This method is implemented for hidden layers only.
+     ******************************************************************************/
+    void backpropagateError(const std::vector<T>& propagatedError);
 
     /*******************************************************************************
      * @brief Performs optimization for dense layer.
@@ -118,7 +202,85 @@ public:
      * @param input        Reference to vector holding the input of the layer.
      * @param learningRate The rate with which to optimize the parameters.
      ******************************************************************************/
-    void optimize(const std::vector<double>& input, const double learningRate = 0.01);
+    void optimize(const std::vector<T>& input, const T learningRate = 0.01);
+
+    /*******************************************************************************
+     * @brief Performs optimization for dense layer and propagates its error to the
+     *        previous layer in one sweep over each weight row. Each row is used 
+     *        to propagate the error before it is updated while it is still in 
+     *        cache, so the weights are only streamed from memory once instead of
+     *        twice as with backpropagate(nextLayer) followed by optimize().
+     * 
+     * @param input        Reference to vector holding the input of the layer.
+     * @param learningRate The rate with which to optimize the parameters.
+     * @param inputError   Reference to vector in which to store the error 
+     *                     propagated to the input, calculated with the weights 
+     *                     before the update. The vector is resized if needed.
+     ******************************************************************************/
+    void optimize(const std::vector<T>& input, const T learningRate, 
+                  std::vector<T>& inputError);
+
+    /*******************************************************************************
+     * @brief Performs feedforward for a batch of inputs as one matrix-matrix 
+     *        product. The state of the dense layer is left unchanged.
+     * 
+     * @param input  Reference to matrix holding one input per row.
+     * @param output Reference to matrix in which to store the output, one row 
+     *               per input. The matrix is resized if needed.
+     ******************************************************************************/
+    void feedforward(const Matrix<T>& input, Matrix<T>& output) const;
+
+    /*******************************************************************************
+     * @brief Performs backpropagation for a batch of outputs of an output layer.
+     * 
+     * @param output    Reference to matrix holding the batch output of the layer.
+     * @param reference Reference to matrix holding one reference per row.
+     * @param error     Reference to matrix in which to store the error, one row 
+     *                  per reference. The matrix is resized if needed.
+     * 
+     * @note This method is implemented for output layers only.
+     ******************************************************************************/
+    void backpropagate(const Matrix<T>& output, const Matrix<T>& reference, 
+                       Matrix<T>& error) const;
+
+    /*******************************************************************************
+     * @brief Performs backpropagation for a batch of outputs of a hidden layer.
+     * 
+     * @param output    Reference to matrix holding the batch output of the layer.
+     * @param nextLayer Reference to the next layer in the neural network.
+     * @param nextError Reference to matrix holding the batch error of the next layer.
+     * @param error     Reference to matrix in which to store the error, one row 
+     *                  per output. The matrix is resized if needed.
+     * 
+     * @note This method is implemented for hidden layers only.
+     ******************************************************************************/
+    void backpropagate(const Matrix<T>& output, const DenseLayerInterface<T>& nextLayer,
+                       const Matrix<T>& nextError, Matrix<T>& error) const;
+
+    /*******************************************************************************
+     * @brief Accumulates the parameter gradients of a batch.
+     * 
+     * @param input          Reference to matrix holding the batch input of the layer.
+     * @param error          Reference to matrix holding the batch error of the layer.
+     * @param biasGradient   Reference to vector to which the bias gradients are added.
+     * @param weightGradient Reference to matrix to which the weight gradients 
+     *                       are added.
+     ******************************************************************************/
+    void accumulateGradients(const Matrix<T>& input, const Matrix<T>& error,
+                             std::vector<T>& biasGradient, 
+                             Matrix<T>& weightGradient) const;
+
+    /*******************************************************************************
+     * @brief Performs optimization for dense layer by applying accumulated 
+     *        gradients.
+     * 
+     * @param biasGradient   Reference to vector holding accumulated bias gradients.
+     * @param weightGradient Reference to matrix holding accumulated weight gradients.
+     * @param learningRate   The rate with which to optimize the parameters.
+     ******************************************************************************/
+    void optimize(const std::vector<T>& biasGradient, 
+                  const Matrix<T>& weightGradient, 
+                  const T learningRate);
 
      /*******************************************************************************
      * @brief Prints stored parameters.
@@ -137,11 +299,31 @@ public:
     DenseLayer& operator=(const DenseLayer&&) = delete; // No move assignment.
 
 private:
-    std::vector<double> myOutput;               // Output of each node.
-    std::vector<double> myError;                // Calculated error of each node.
-    std::vector<double> myBias;                 // Bias of each node.
-    std::vector<std::vector<double>> myWeights; // Weights of each node.
-    std::unique_ptr<ActFuncCalc> myActFuncCalc; // Activation function calculator.
+
+    /*******************************************************************************
+     * @brief Checks that the shape of specified gradients match the dense layer.
+     * 
+     * @param biasGradient   Reference to vector holding bias gradients.
+     * @param weightGradient Reference to matrix holding weight gradients.
+     ******************************************************************************/
+    void checkGradientShape(const std::vector<T>& biasGradient, 
+                            const Matrix<T>& weightGradient) const;
+
+    /*******************************************************************************
+     * @brief Multiplies the error of each node with the activation function 
+     *        gradient, either from the cache if it was filled by the last
+     *        feedforward or calculated from the output.
+     ******************************************************************************/
+    void multiplyGradient();
+
+    std::vector<T> myOutput;                       // Output of each node.
+    std::vector<T> myError;                        // Calculated error of each node.
+    std::vector<T> myGradient;                     // Cached activation gradient of each node.
+    std::vector<T> myBias;                         // Bias of each node.
+    Matrix<T> myWeights;                           // Weights of each node (one row per node).
+    std::unique_ptr<ActFuncCalc<T>> myActFuncCalc; // Activation function calculator.
+    bool myGradientCaching;                        // Indicates if gradients are cached.
+    bool myGradientCached;                         // Indicates if the cache matches the output.
 };
 
 } // namespace ml
\ No newline at end of file
@@ -5,12 +5,18 @@
 
 #include <vector>
 
+#include "act_func.h"
+#include "matrix.h"
+
 namespace ml
 {
 
 /*******************************************************************************
  * @brief Interface for dense layers in neural networks.
+ * 
+ * @tparam T The floating-point type of the parameters (default = double).
  ******************************************************************************/
+template <typename T = double>
 class DenseLayerInterface
 {
 public:
@@ -25,29 +31,43 @@ public:
      *
      * @return Reference to vector holding the output of the dense layer.
      ******************************************************************************/
-    virtual const std::vector<double>& output() const = 0;
+    virtual const std::vector<T>& output() const = 0;
 
     /*******************************************************************************
      * @brief Provides the error of the dense layer.
      *
      * @return Reference to vector holding the error of the dense layer.
      ******************************************************************************/
-    virtual const std::vector<double>& error() const = 0;
+    virtual const std::vector<T>& error() const = 0;
 
     /*******************************************************************************
      * @brief Provides the bias of the dense layer.
      *
      * @return Reference to vector holding the bias of the dense layer.
      ******************************************************************************/
-    virtual const std::vector<double>& bias() const = 0;
+    virtual const std::vector<T>& bias() const = 0;
 
     /*******************************************************************************
      * @brief Provides the weights of the dense layer.
      *
-     * @return Reference to two-dimensional vector holding the weights of 
-     *         the dense layer.
+     * @return Reference to contiguous row-major matrix holding the weights of 
+     *         the dense layer, where each row holds the weights of one node.
+     ******************************************************************************/
+    virtual const Matrix<T>& weights() const = 0;
+
+    /*******************************************************************************
+     * @brief Provides the activation function of the dense layer.
+     * 
+     * @return The activation function as an enumerator of enum ActFunc.
+     ******************************************************************************/
+    virtual ActFunc actFunc() const = 0;
+
+    /*******************************************************************************
+     * @brief Provides the accuracy of the hyperbolic tangent of the dense layer.
+     * 
+     * @return The accuracy as an enumerator of enum TanhPrecision.
      ******************************************************************************/
-    virtual const std::vector<std::vector<double>>& weights() const = 0;
+    virtual TanhPrecision tanhPrecision() const = 0;
 
     /*******************************************************************************
      * @brief Provides the number of nodes in the dense layer.
@@ -62,13 +82,53 @@ public:
      * @return The number of weights per node as an unsigned integer.
      ******************************************************************************/
     virtual std::size_t weightCount() const = 0;
+
+    /*******************************************************************************
+     * @brief Indicates if the activation function gradient of each node is cached
+     *        during feedforward, so that backpropagation is a pure multiplication.
+     * 
+     * @return True if gradient caching is enabled, else false.
+     ******************************************************************************/
+    virtual bool gradientCaching() const = 0;
+
+    /*******************************************************************************
+     * @brief Enables or disables caching of the activation function gradients.
+     *        Caching is enabled by default for new layers and disabled for 
+     *        layers created from existing parameters, such as loaded models.
+     *        Disabling it releases the cache. The gradients are then calculated
+     *        from the stored output during backpropagation instead.
+     * 
+     * @param enable True to enable gradient caching, false to disable it.
+     ******************************************************************************/
+    virtual void setGradientCaching(const bool enable) = 0;
     
     /*******************************************************************************
-     * @brief Performs feedforward for dense layer.
+     * @brief Performs feedforward for dense layer. The gradient cache is not
+     *        filled, see feedforwardForTraining.
+     * 
+     * @param input Reference to vector holding the input of the dense layer.
+     ******************************************************************************/
+    virtual void feedforward(const std::vector<T>& input) = 0;
+
+    /*******************************************************************************
+     * @brief Performs feedforward for dense layer ahead of backpropagation. If
+     *        gradient caching is enabled, the activation function gradient of
+     *        each node is cached as well, so that the following backpropagation
+     *        is a pure multiplication.
      * 
      * @param input Reference to vector holding the input of the dense layer.
      ******************************************************************************/
-    virtual void feedforward(const std::vector<double>& input) = 0;
+    virtual void feedforwardForTraining(const std::vector<T>& input) = 0;
+
+    /*******************************************************************************
+     * @brief Performs feedforward for a single input without modifying the state
+     *        of the dense layer, which makes it safe to call from several threads.
+     * 
+     * @param input  Reference to vector holding the input of the dense layer.
+     * @param output Reference to vector in which to store the output. The vector 
+     *               is resized if needed.
+     ******************************************************************************/
+    virtual void feedforward(const std::vector<T>& input, std::vector<T>& output) const = 0;
 
     /*******************************************************************************
      * @brief Performs backpropagation for output layer.
@@ -77,7 +137,7 @@ public:
      * 
      * @note This method is implemented for output layers only.
      ******************************************************************************/
-    virtual void backpropagate(const std::vector<double>& reference) = 0;
+    virtual void backpropagate(const std::vector<T>& reference) = 0;
 
     /*******************************************************************************
      * @brief Performs backpropagation for hidden layer.
@@ -88,13 +148,104 @@ public:
      ******************************************************************************/
     virtual void backpropagate(const DenseLayerInterface& nextLayer) = 0;
 
+    /*******************************************************************************
+     * @brief Performs backpropagation for hidden layer from the error propagated
+     *        by the next layer, i.e. the errors of the next layer weighted with 
+     *        its weights. This is used in combination with the fused optimization
+     *        of the next layer, see optimize(input, learningRate, inputError).
+     * 
+     * @param propagatedError Reference to vector holding the propagated error, 
+     *                        one value per node.
+     * 
+     * @note This method is implemented for hidden layers only.
+     ******************************************************************************/
+    virtual void backpropagateError(const std::vector<T>& propagatedError) = 0;
+
     /*******************************************************************************
      * @brief Performs optimization for dense layer.
      * 
      * @param input        Reference to vector holding the input of the layer.
      * @param learningRate The rate with which to optimize the parameters.
      ******************************************************************************/
-    virtual void optimize(const std::vector<double>& input, const double learningRate = 0.01) = 0;
+    virtual void optimize(const std::vector<T>& input, const T learningRate = 0.01) = 0;
+
+    /*******************************************************************************
+     * @brief Performs optimization for dense layer and propagates its error to the
+     *        previous layer in one sweep over each weight row. Each row is used 
+     *        to propagate the error before it is updated while it is still in 
+     *        cache, so the weights are only streamed from memory once instead of
+     *        twice as with backpropagate(nextLayer) followed by optimize().
+     * 
+     * @param input        Reference to vector holding the input of the layer.
+     * @param learningRate The rate with which to optimize the parameters.
+     * @param inputError   Reference to vector in which to store the error 
+     *                     propagated to the input, calculated with the weights 
+     *                     before the update. The vector is resized if needed.
+     ******************************************************************************/
+    virtual void optimize(const std::vector<T>& input, const T learningRate, 
+                          std::vector<T>& inputError) = 0;
+
+    /*******************************************************************************
+     * @brief Performs feedforward for a batch of inputs as one matrix-matrix 
+     *        product. The state of the dense layer is left unchanged.
+     * 
+     * @param input  Reference to matrix holding one input per row.
+     * @param output Reference to matrix in which to store the output, one row 
+     *               per input. The matrix is resized if needed.
+     ******************************************************************************/
+    virtual void feedforward(const Matrix<T>& input, Matrix<T>& output) const = 0;
+
+    /*******************************************************************************
+     * @brief Performs backpropagation for a batch of outputs of an output layer.
+     * 
+     * @param output    Reference to matrix holding the batch output of the layer.
+     * @param reference Reference to matrix holding one reference per row.
+     * @param error     Reference to matrix in which to store the error, one row 
+     *                  per reference. The matrix is resized if needed.
+     * 
+     * @note This method is implemented for output layers only.
+     ******************************************************************************/
+    virtual void backpropagate(const Matrix<T>& output, const Matrix<T>& reference, 
+                               Matrix<T>& error) const = 0;
+
+    /*******************************************************************************
+     * @brief Performs backpropagation for a batch of outputs of a hidden layer.
+     * 
+     * @param output    Reference to matrix holding the batch output of the layer.
+     * @param nextLayer Reference to the next layer in the neural network.
+     * @param nextError Reference to matrix holding the batch error of the next layer.
+     * @param error     Reference to matrix in which to store the error, one row 
+     *                  per output. The matrix is resized if needed.
+     * 
+     * @note This method is implemented for hidden layers only.
+     ******************************************************************************/
+    virtual void backpropagate(const Matrix<T>& output, const DenseLayerInterface& nextLayer,
+                               const Matrix<T>& nextError, Matrix<T>& error) const = 0;
+
+    /*******************************************************************************
+     * @brief Accumulates the parameter gradients of a batch.
+     * 
+     * @param input          Reference to matrix holding the batch input of the layer.
+     * @param error          Reference to matrix holding the batch error of the layer.
+     * @param biasGradient   Reference to vector to which the bias gradients are added.
+     * @param weightGradient Reference to matrix to which the weight gradients 
+     *                       are added.
+     ******************************************************************************/
+    virtual void accumulateGradients(const Matrix<T>& input, const Matrix<T>& error,
+                                     std::vector<T>& biasGradient, 
+                                     Matrix<T>& weightGradient) const = 0;
+
+    /*******************************************************************************
+     * @brief Performs optimization for dense layer by applying accumulated 
+     *        gradients.
+     * 
+     * @param biasGradient   Reference to vector holding accumulated bias gradients.
+     * @param weightGradient Reference to matrix holding accumulated weight gradients.
+     * @param learningRate   The rate with which to optimize the parameters.
+     ******************************************************************************/
+    virtual void optimize(const std::vector<T>& biasGradient, 
+                          const Matrix<T>& weightGradient, 
+                          const T learningRate) = 0;
 };
 
 } // namespace ml
\ No newline at end of file
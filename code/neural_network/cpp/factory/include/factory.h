@@ -8,7 +8,9 @@
 
 #include "act_func_calc.h"
 #include "dense_layer_interface.h"
+#include "matrix.h"
 #include "neural_network_interface.h"
+#include "quantized_network.h"
 
 namespace ml
 {
@@ -18,6 +20,8 @@ namespace factory
 /*******************************************************************************
  * @brief Creates new neural network.
  * 
+ * @tparam T The floating-point type of the parameters (default = double).
+ * 
  * @param inputCount       The number of inputs in the neural network.
  * @param hiddenNodesCount The number of nodes in in the network's single 
  *                         hidden layer.
@@ -26,65 +30,102 @@ namespace factory
  *                         (default = ReLU).
  * @param actFuncOutput    Activation function of the output layer 
  *                         (default = ReLU).
+ * @param tanhPrecision    The accuracy of the hyperbolic tangent in layers
+ *                         using tanh activation (default = exact).
  * 
  * @return Pointer to the new neural network.
  ******************************************************************************/
-std::unique_ptr<NeuralNetworkInterface> neuralNetwork(const std::size_t inputCount, 
-                                                      const std::size_t hiddenNodesCount,
-                                                      const std::size_t outputCount, 
-                                                      const ActFunc actFuncHidden = ActFunc::Relu, 
-                                                      const ActFunc actFuncOutput = ActFunc::Relu);
+template <typename T = double>
+std::unique_ptr<NeuralNetworkInterface<T>> neuralNetwork(const std::size_t inputCount, 
+                                                         const std::size_t hiddenNodesCount,
+                                                         const std::size_t outputCount, 
+                                                         const ActFunc actFuncHidden = ActFunc::Relu, 
+                                                         const ActFunc actFuncOutput = ActFunc::Relu,
+                                                         const TanhPrecision tanhPrecision = TanhPrecision::Exact);
+
+/*******************************************************************************
+ * @brief Creates new int8 quantized network from a trained neural network.
+ * 
+ * @tparam T The floating-point type of the parameters (default = double).
+ * 
+ * @param network Reference to the trained neural network to quantize.
+ * 
+ * @return Pointer to the new quantized network.
+ ******************************************************************************/
+template <typename T = double>
+std::unique_ptr<QuantizedNetwork<T>> quantizedNetwork(const NeuralNetworkInterface<T>& network);
 
 /*******************************************************************************
  * @brief Creates new dense layer.
  *
- * @param nodeCount   The number of nodes in the new layer.
- * @param weightCount The number of weights per node in the new layer.
- * @param actFunc     The activation function of the layer (default = ReLU).
+ * @tparam T The floating-point type of the parameters (default = double).
+ * 
+ * @param nodeCount     The number of nodes in the new layer.
+ * @param weightCount   The number of weights per node in the new layer.
+ * @param actFunc       The activation function of the layer (default = ReLU).
+ * @param tanhPrecision The accuracy of the hyperbolic tangent, which is only
+ *                      used if actFunc is ActFunc::Tanh (default = exact).
  * 
  * @return Pointer to the new dense layer.
  ******************************************************************************/
-std::unique_ptr<DenseLayerInterface> denseLayer(const std::size_t nodeCount, 
-                                                const std::size_t weightCount, 
-                                                const ActFunc actFunc = ActFunc::Relu);
+template <typename T = double>
+std::unique_ptr<DenseLayerInterface<T>> denseLayer(const std::size_t nodeCount, 
+                                                   const std::size_t weightCount, 
+                                                   const ActFunc actFunc = ActFunc::Relu,
+                                                   const TanhPrecision tanhPrecision = TanhPrecision::Exact);
 
 /*******************************************************************************
  * @brief Creates new activation function calculator.
  * 
- * @param actFunc The type of activation function to use for the calculations.
+ * @tparam T The floating-point type of the calculations (default = double).
+ * 
+ * @param actFunc       The type of activation function to use for the 
+ *                      calculations.
+ * @param tanhPrecision The accuracy of the hyperbolic tangent, which is only
+ *                      used if actFunc is ActFunc::Tanh (default = exact).
  * 
  * @return Pointer to the new activation function calculator.
  ******************************************************************************/
-std::unique_ptr<ActFuncCalc> actFuncCalc(const ActFunc actFunc);
+template <typename T = double>
+std::unique_ptr<ActFuncCalc<T>> actFuncCalc(const ActFunc actFunc, 
+                                            const TanhPrecision tanhPrecision = TanhPrecision::Exact);
 
 /*******************************************************************************
  * @brief Creates and initializes one-dimensional parameter vector.
  * 
+ * @tparam T The floating-point type of the parameters (default = double).
+ * 
  * @param size       The size of the vector.
  * @param startValue The starting value for each parameter (default = 0.0).
  * 
  * @return New initialized one-dimensional vector.
  ******************************************************************************/
-std::vector<double> parameterVector(const std::size_t size, 
-                                    const double startValue = 0.0);
+template <typename T = double>
+std::vector<T> parameterVector(const std::size_t size, 
+                               const T startValue = 0.0);
 
 /*******************************************************************************
  * @brief Creates and initializes two-dimensional parameter vector.
  * 
+ * @tparam T The floating-point type of the parameters (default = double).
+ * 
  * @param columnCount The number of columns of the vector.
  * @param rowCount    The number of rows of the vector.
  * @param startValue  The starting value for each parameter (default = 0.0).
  * 
  * @return New initialized two-dimensional vector.
  ******************************************************************************/
-std::vector<std::vector<double>> parameterVector(const std::size_t columnCount,
-                                                 const std::size_t rowCount,
-                                                 const double startValue = 0.0);
+template <typename T = double>
+std::vector<std::vector<T>> parameterVector(const std::size_t columnCount,
+                                            const std::size_t rowCount,
+                                            const T startValue = 0.0);
 
 /*******************************************************************************
  * @brief Creates one-dimensional parameter vector initialized with randomly 
  *        generated values in specified range [min, max].
  * 
+ * @tparam T The floating-point type of the parameters (default = double).
+ * 
  * @param size The size of the vector.
  * @param min  The minimum permitted random value (default = 0.0).
  * @param max  The maximum permitted random value (default = 1.0).
@@ -92,14 +133,17 @@ std::vector<std::vector<double>> parameterVector(const std::size_t columnCount,
  * @return New one-dimensional parameter vector initialized with randomly 
  *         generated values.
  ******************************************************************************/
-std::vector<double> randomParameterVector(const std::size_t size, 
-                                          const double min = 0.0, 
-                                          const double max = 1.0);
+template <typename T = double>
+std::vector<T> randomParameterVector(const std::size_t size, 
+                                     const T min = 0.0, 
+                                     const T max = 1.0);
 
 /*******************************************************************************
  * @brief Creates two-dimensional parameter vector initialized with randomly 
  *        generated values in range [min, max].
  * 
+ * @tparam T The floating-point type of the parameters (default = double).
+ * 
  * @param columnCount The number of columns of the vector.
  * @param rowCount    The number of rows of the vector.
  * @param min         The minimum permitted random value (default = 0.0).
@@ -108,9 +152,45 @@ std::vector<double> randomParameterVector(const std::size_t size,
  * @return New two-dimensional parameter vector initialized with randomly 
  *         generated values.
  ******************************************************************************/
-std::vector<std::vector<double>> randomParameterVector(const std::size_t columnCount,
-                                                       const std::size_t rowCount,
-                                                       const double min = 0.0, 
-                                                       const double max = 1.0);
+template <typename T = double>
+std::vector<std::vector<T>> randomParameterVector(const std::size_t columnCount,
+                                                  const std::size_t rowCount,
+                                                  const T min = 0.0, 
+                                                  const T max = 1.0);
+
+/*******************************************************************************
+ * @brief Creates and initializes contiguous parameter matrix.
+ * 
+ * @tparam T The floating-point type of the parameters (default = double).
+ * 
+ * @param rowCount    The number of rows of the matrix.
+ * @param columnCount The number of columns of the matrix.
+ * @param startValue  The starting value for each parameter (default = 0.0).
+ * 
+ * @return New initialized matrix.
+ ******************************************************************************/
+template <typename T = double>
+Matrix<T> parameterMatrix(const std::size_t rowCount,
+                          const std::size_t columnCount,
+                          const T startValue = 0.0);
+
+/*******************************************************************************
+ * @brief Creates contiguous parameter matrix initialized with randomly 
+ *        generated values in range [min, max].
+ * 
+ * @tparam T The floating-point type of the parameters (default = double).
+ * 
+ * @param rowCount    The number of rows of the matrix.
+ * @param columnCount The number of columns of the matrix.
+ * @param min         The minimum permitted random value (default = 0.0).
+ * @param max         The maximum permitted random value (default = 1.0).
+ * 
+ * @return New matrix initialized with randomly generated values.
+ ******************************************************************************/
+template <typename T = double>
+Matrix<T> randomParameterMatrix(const std::size_t rowCount,
+                                const std::size_t columnCount,
+                                const T min = 0.0, 
+                                const T max = 1.0);
 } // namespace factory
 } // namespace ml
\ No newline at end of file
@@ -0,0 +1,32 @@
+/*******************************************************************************
+ * @brief Implementation of scratch contexts for reentrant inference.
+ ******************************************************************************/
+#pragma once
+
+#include <vector>
+
+#include "matrix.h"
+
+namespace ml
+{
+
+/*******************************************************************************
+ * @brief Structure holding the activation buffers of one prediction, which 
+ *        makes it possible to predict without modifying the neural network.
+ * 
+ *        Any number of threads can share one trained neural network as long 
+ *        as each thread uses its own context. The buffers are resized on first
+ *        use and then reused, so no memory is allocated in steady state as 
+ *        long as the shape of the input stays the same.
+ * 
+ * @tparam T The floating-point type of the buffers (default = double).
+ ******************************************************************************/
+template <typename T = double>
+struct InferenceContext
+{
+    std::vector<T> hiddenOutput; // Output of the hidden layer.
+    std::vector<T> output;       // Output of the network.
+    Matrix<T> hiddenBatchOutput; // Output of the hidden layer for a batch.
+};
+
+} // namespace ml
@@ -0,0 +1,213 @@
+/*******************************************************************************
+ * @brief Implementation of local inference servers with dynamic batching.
+ ******************************************************************************/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "inference_context.h"
+#include "matrix.h"
+#include "neural_network_interface.h"
+
+namespace ml
+{
+
+/*******************************************************************************
+ * @brief Enum representing the message types of the inference server protocol.
+ *
+ *        Each message consists of a MessageHeader followed by a payload of
+ *        MessageHeader::size bytes. All fields use native byte order, since
+ *        the server is only reachable via a local Unix domain socket.
+ ******************************************************************************/
+enum class MessageType : std::uint32_t
+{
+    Predict = 1U, // Request: one input as 32-bit floats.
+    Stats   = 2U, // Request: empty payload.
+    Output  = 3U, // Response: the predicted output as 32-bit floats.
+    Report  = 4U, // Response: the server statistics as JSON text.
+    Error   = 5U, // Response: an error message as text.
+};
+
+/*******************************************************************************
+ * @brief Structure holding the header of a message of the inference server
+ *        protocol.
+ ******************************************************************************/
+struct MessageHeader
+{
+    MessageType type;   // The type of the message.
+    std::uint32_t size; // The size of the payload in bytes.
+};
+
+/*******************************************************************************
+ * @brief Structure holding the policy for coalescing requests into batches.
+ *        A batch is predicted as soon as it holds the maximum number of
+ *        requests, or when its oldest request has waited the maximum latency.
+ ******************************************************************************/
+struct BatchPolicy
+{
+    std::size_t maxBatchSize{32U};             // Max number of requests per batch.
+    std::chrono::microseconds maxLatency{500}; // Max time to wait for a full batch.
+};
+
+/*******************************************************************************
+ * @brief Class implementation of local inference servers, which serve
+ *        predictions of a trained neural network over a Unix domain socket.
+ *
+ *        Each client connection is served by its own thread, while a single
+ *        batching thread coalesces concurrent requests into batches according
+ *        to the batch policy. Each batch is predicted as one matrix and each
+ *        client is answered with its row of the batch output.
+ *
+ *        Per-request latency (from receiving the request to sending the
+ *        response) and batch sizes are collected in histograms, which are
+ *        provided as JSON via the stats request.
+ *
+ *        The neural network must outlive the server and must not be trained
+ *        while the server is running. This class is non-copyable and
+ *        non-movable. Explicit instantiations are provided for float and double.
+ *
+ * @tparam T The floating-point type of the neural network (default = double).
+ ******************************************************************************/
+template <typename T = double>
+class InferenceServer
+{
+public:
+
+    /*******************************************************************************
+     * @brief Creates new inference server. The socket is not opened until the
+     *        server is run.
+     *
+     * @param network    Reference to the trained neural network to serve.
+     * @param socketPath The path of the Unix domain socket to listen on. Any
+     *                   existing file at the path is replaced.
+     * @param policy     The policy for coalescing requests into batches.
+     ******************************************************************************/
+    InferenceServer(const NeuralNetworkInterface<T>& network, const std::string& socketPath,
+                    const BatchPolicy& policy = BatchPolicy{});
+
+    /*******************************************************************************
+     * @brief Deletes inference server. The server is stopped if running, and
+     *        the destructor waits until run has returned on the thread running
+     *        it. A server must not be deleted while another thread may still
+     *        be about to call run.
+     ******************************************************************************/
+    ~InferenceServer();
+
+    /*******************************************************************************
+     * @brief Runs the inference server until stop is called. Connections are
+     *        accepted on the calling thread. If stop has already been called,
+     *        for instance before the calling thread reached run, run returns
+     *        as soon as the socket has been set up. A stopped server cannot be
+     *        run again.
+     ******************************************************************************/
+    void run();
+
+    /*******************************************************************************
+     * @brief Stops the inference server. Pending requests are answered before
+     *        run returns. This method may be called from any thread.
+     ******************************************************************************/
+    void stop();
+
+    /*******************************************************************************
+     * @brief Provides the server statistics, i.e. the request and batch counts
+     *        along with the latency and batch size histograms.
+     *
+     * @return The statistics as a JSON string.
+     ******************************************************************************/
+    std::string stats() const;
+
+    InferenceServer()                                  = delete; // No default constructor.
+    InferenceServer(const InferenceServer&)            = delete; // No copy constructor.
+    InferenceServer(InferenceServer&&)                 = delete; // No move constructor.
+    InferenceServer& operator=(const InferenceServer&) = delete; // No copy assignment.
+    InferenceServer& operator=(InferenceServer&&)      = delete; // No move assignment.
+
+private:
+
+    /*******************************************************************************
+     * @brief The number of latency histogram buckets. Bucket i holds latencies
+     *        below 2^i microseconds, and the last bucket holds the rest.
+     ******************************************************************************/
+    static constexpr std::size_t LatencyBucketCount{24U};
+
+    /*******************************************************************************
+     * @brief Structure holding a prediction request waiting to be batched.
+     ******************************************************************************/
+    struct Request
+    {
+        std::vector<T> input;                           // Input of the request.
+        std::vector<T> output;                          // Predicted output.
+        std::chrono::steady_clock::time_point received; // Time the request was received.
+        bool done;                                      // Indicates if output is ready.
+    };
+
+    /*******************************************************************************
+     * @brief Serves the requests of a connected client until it disconnects.
+     *
+     * @param client File descriptor of the client socket.
+     ******************************************************************************/
+    void serve(const int client);
+
+    /*******************************************************************************
+     * @brief Predicts batches of queued requests until the server is stopped.
+     ******************************************************************************/
+    void processBatches();
+
+    /*******************************************************************************
+     * @brief Queues a request and waits until it has been predicted.
+     *
+     * @param request Reference to the request to predict.
+     ******************************************************************************/
+    void predict(Request& request);
+
+    /*******************************************************************************
+     * @brief Records the latency of an answered request.
+     *
+     * @param received The time the request was received.
+     ******************************************************************************/
+    void recordLatency(const std::chrono::steady_clock::time_point received);
+
+    /*******************************************************************************
+     * @brief Signals that run is about to return, which wakes up the destructor
+     *        if it waits for run.
+     ******************************************************************************/
+    void finishRun();
+
+    const NeuralNetworkInterface<T>& myNetwork;        // The neural network to serve.
+    const std::string mySocketPath;                    // Path of the Unix domain socket.
+    const BatchPolicy myPolicy;                        // Policy for coalescing requests.
+    std::atomic<bool> myStopRequested;                 // Indicates if stop has been called.
+    std::atomic<int> myListener;                       // Listening socket (-1 if closed).
+
+    std::mutex myQueueMutex;                           // Protects the request queue.
+    std::condition_variable myQueueCondition;          // Signals queued requests.
+    std::condition_variable myDoneCondition;           // Signals predicted requests.
+    std::deque<Request*> myQueue;                      // Requests waiting to be batched.
+    bool myBatching;                                   // Indicates if batches are processed.
+    InferenceContext<T> myContext;                     // Buffers of batch prediction.
+    Matrix<T> myBatchInput;                            // Input of the current batch.
+    Matrix<T> myBatchOutput;                           // Output of the current batch.
+
+    std::mutex myClientMutex;                          // Protects the client set.
+    std::condition_variable myClientCondition;         // Signals disconnected clients.
+    std::unordered_set<int> myClients;                 // Sockets of connected clients.
+    std::condition_variable myRunCondition;            // Signals that run has returned.
+    bool myRunning;                                    // Indicates if run is executing.
+
+    mutable std::mutex myStatsMutex;                   // Protects the statistics.
+    std::uint64_t myRequestCount;                      // Number of answered requests.
+    std::uint64_t myBatchCount;                        // Number of predicted batches.
+    std::array<std::uint64_t, LatencyBucketCount> myLatencyHistogram; // Latency buckets.
+    std::vector<std::uint64_t> myBatchSizeHistogram;   // Number of batches per size.
+};
+
+} // namespace ml
@@ -0,0 +1,22 @@
+/*******************************************************************************
+ * @brief Implementation of instruction sets available for computation kernels.
+ ******************************************************************************/
+#pragma once
+
+namespace ml
+{
+
+/*******************************************************************************
+ * @brief Enum representing the instruction sets the computation kernels can
+ *        be dispatched to, ordered from least to most capable.
+ ******************************************************************************/
+enum class InstructionSet : unsigned
+{
+    Scalar, // Portable scalar implementation.
+    Sse2,   // 128-bit SSE2 instructions.
+    Avx2,   // 256-bit AVX2 instructions with fused multiply-add (FMA).
+    Avx512, // 512-bit AVX-512 foundation instructions.
+    Count,  // The number of instruction sets available.
+};
+
+} // namespace ml
@@ -0,0 +1,266 @@
+/*******************************************************************************
+ * @brief Computation kernels for the inner loops of dense layers and for
+ *        activation functions applied to entire layers.
+ *
+ *        Each kernel is implemented in scalar, SSE2, AVX2 and AVX-512
+ *        versions. The most capable instruction set supported by the CPU is
+ *        detected via cpuid upon first use, so that the same binary can be
+ *        used on different processors.
+ ******************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "act_func.h"
+#include "instruction_set.h"
+
+namespace ml
+{
+namespace kernels
+{
+
+/*******************************************************************************
+ * @brief Provides the most capable instruction set supported by the CPU and
+ *        the operating system.
+ *
+ * @return The supported instruction set as an enumerator of enum class
+ *         InstructionSet.
+ ******************************************************************************/
+InstructionSet supportedInstructionSet();
+
+/*******************************************************************************
+ * @brief Provides the instruction set currently used by the kernels.
+ *
+ * @return The selected instruction set as an enumerator of enum class
+ *         InstructionSet.
+ ******************************************************************************/
+InstructionSet instructionSet();
+
+/*******************************************************************************
+ * @brief Selects the instruction set to use for the kernels, for instance to
+ *        compare implementations.
+ *
+ * @param instructionSet The instruction set to use.
+ *
+ * @note This function is not thread-safe and should not be called while
+ *       kernels are running on other threads.
+ ******************************************************************************/
+void selectInstructionSet(const InstructionSet instructionSet);
+
+/*******************************************************************************
+ * @brief Provides the name of specified instruction set as a string.
+ *
+ * @param instructionSet The instruction set.
+ *
+ * @return The name of the instruction set as a string.
+ ******************************************************************************/
+const char* instructionSetName(const InstructionSet instructionSet);
+
+/*******************************************************************************
+ * @brief Calculates the dot product of two sequences.
+ *
+ * @param x    Pointer to the first sequence.
+ * @param y    Pointer to the second sequence.
+ * @param size The number of elements in each sequence.
+ *
+ * @return The dot product as a double.
+ ******************************************************************************/
+double dot(const double* x, const double* y, const std::size_t size);
+
+/*******************************************************************************
+ * @brief Adds a scaled sequence to another, i.e. y += alpha * x.
+ *
+ * @param alpha The scale factor.
+ * @param x     Pointer to the sequence to scale and add.
+ * @param y     Pointer to the sequence to update.
+ * @param size  The number of elements in each sequence.
+ ******************************************************************************/
+void axpy(const double alpha, const double* x, double* y, const std::size_t size);
+
+/*******************************************************************************
+ * @brief Calculates the dot product of two single-precision sequences.
+ *
+ * @param x    Pointer to the first sequence.
+ * @param y    Pointer to the second sequence.
+ * @param size The number of elements in each sequence.
+ *
+ * @return The dot product as a float.
+ ******************************************************************************/
+float dot(const float* x, const float* y, const std::size_t size);
+
+/*******************************************************************************
+ * @brief Adds a scaled single-precision sequence to another, i.e. y += alpha * x.
+ *
+ * @param alpha The scale factor.
+ * @param x     Pointer to the sequence to scale and add.
+ * @param y     Pointer to the sequence to update.
+ * @param size  The number of elements in each sequence.
+ ******************************************************************************/
+void axpy(const float alpha, const float* x, float* y, const std::size_t size);
+
+/*******************************************************************************
+ * @brief Adds the product of a transposed row-major matrix and a sequence to 
+ *        another sequence, i.e. y += A^T * x. The rows of A are added 
+ *        four at a time with unit-stride access, so that y is only loaded and 
+ *        stored once per four rows.
+ *
+ * @param x        Pointer to the sequence to multiply with, one element per row.
+ * @param a        Pointer to the first row of the matrix.
+ * @param rowCount The number of rows of the matrix.
+ * @param stride   The distance between consecutive rows in number of elements.
+ * @param y        Pointer to the sequence to update, one element per column.
+ * @param size     The number of columns of the matrix.
+ ******************************************************************************/
+void transposedProduct(const double* x, const double* a, const std::size_t rowCount, 
+                       const std::size_t stride, double* y, const std::size_t size);
+
+/*******************************************************************************
+ * @brief Adds the product of a transposed row-major matrix and a sequence to 
+ *        another sequence (single precision), i.e. y += A^T * x. The rows of A are added 
+ *        four at a time with unit-stride access, so that y is only loaded and 
+ *        stored once per four rows.
+ *
+ * @param x        Pointer to the sequence to multiply with, one element per row.
+ * @param a        Pointer to the first row of the matrix.
+ * @param rowCount The number of rows of the matrix.
+ * @param stride   The distance between consecutive rows in number of elements.
+ * @param y        Pointer to the sequence to update, one element per column.
+ * @param size     The number of columns of the matrix.
+ ******************************************************************************/
+void transposedProduct(const float* x, const float* a, const std::size_t rowCount, 
+                       const std::size_t stride, float* y, const std::size_t size);
+
+/*******************************************************************************
+ * @brief Propagates the error of a node to the previous layer and updates the
+ *        node's weights in one sweep over the weights, i.e. 
+ *        y += alpha * w followed by w += beta * x for each element. The weights
+ *        are thus only streamed from memory once.
+ *
+ * @param alpha The scale factor of the weights, typically the node's error.
+ * @param beta  The scale factor of x, typically the error times the learning rate.
+ * @param x     Pointer to the input of the layer.
+ * @param w     Pointer to the weights to propagate with and then update.
+ * @param y     Pointer to the error of the previous layer to add to.
+ * @param size  The number of elements in each sequence.
+ ******************************************************************************/
+void fusedAxpy(const double alpha, const double beta, const double* x, double* w, double* y, 
+               const std::size_t size);
+
+/*******************************************************************************
+ * @brief Propagates the error of a node to the previous layer and updates the
+ *        node's weights in one sweep over the weights (single precision), i.e. 
+ *        y += alpha * w followed by w += beta * x for each element. The weights
+ *        are thus only streamed from memory once.
+ *
+ * @param alpha The scale factor of the weights, typically the node's error.
+ * @param beta  The scale factor of x, typically the error times the learning rate.
+ * @param x     Pointer to the input of the layer.
+ * @param w     Pointer to the weights to propagate with and then update.
+ * @param y     Pointer to the error of the previous layer to add to.
+ * @param size  The number of elements in each sequence.
+ ******************************************************************************/
+void fusedAxpy(const float alpha, const float beta, const float* x, float* w, float* y, 
+               const std::size_t size);
+
+/*******************************************************************************
+ * @brief Calculates the dot product of two 8-bit integer sequences. The 
+ *        products are accumulated in 32 bits, which cannot overflow for 
+ *        sequences shorter than 2^17 elements.
+ *
+ * @param x    Pointer to the first sequence.
+ * @param y    Pointer to the second sequence.
+ * @param size The number of elements in each sequence.
+ *
+ * @return The dot product as a 32-bit integer.
+ ******************************************************************************/
+std::int32_t dot(const std::int8_t* x, const std::int8_t* y, const std::size_t size);
+
+/*******************************************************************************
+ * @brief Applies the ReLU activation to a sequence, i.e. y = max(x, 0).
+ *
+ * @param x    Pointer to the sequence to apply the activation to.
+ * @param y    Pointer to the sequence in which to store the result. 
+ *             May be the same as x.
+ * @param size The number of elements in each sequence.
+ ******************************************************************************/
+void relu(const double* x, double* y, const std::size_t size);
+
+/*******************************************************************************
+ * @brief Applies the ReLU activation to a single-precision sequence.
+ *
+ * @param x    Pointer to the sequence to apply the activation to.
+ * @param y    Pointer to the sequence in which to store the result. 
+ *             May be the same as x.
+ * @param size The number of elements in each sequence.
+ ******************************************************************************/
+void relu(const float* x, float* y, const std::size_t size);
+
+/*******************************************************************************
+ * @brief Multiplies a sequence with the ReLU gradient of another, i.e. each 
+ *        element of y is kept where x > 0 and set to 0 elsewhere.
+ *
+ * @param x    Pointer to the sequence whose ReLU gradient to use.
+ * @param y    Pointer to the sequence to multiply with the gradient.
+ * @param size The number of elements in each sequence.
+ ******************************************************************************/
+void reluGradient(const double* x, double* y, const std::size_t size);
+
+/*******************************************************************************
+ * @brief Multiplies a single-precision sequence with the ReLU gradient of 
+ *        another, i.e. each element of y is kept where x > 0 and set to 0 
+ *        elsewhere.
+ *
+ * @param x    Pointer to the sequence whose ReLU gradient to use.
+ * @param y    Pointer to the sequence to multiply with the gradient.
+ * @param size The number of elements in each sequence.
+ ******************************************************************************/
+void reluGradient(const float* x, float* y, const std::size_t size);
+
+/*******************************************************************************
+ * @brief Multiplies a sequence with the tanh gradient of another holding tanh
+ *        outputs, i.e. y *= 1 - x^2.
+ *
+ * @param x    Pointer to the sequence of tanh outputs whose gradient to use.
+ * @param y    Pointer to the sequence to multiply with the gradient.
+ * @param size The number of elements in each sequence.
+ ******************************************************************************/
+void tanhGradient(const double* x, double* y, const std::size_t size);
+
+/*******************************************************************************
+ * @brief Multiplies a single-precision sequence with the tanh gradient of 
+ *        another holding tanh outputs, i.e. y *= 1 - x^2.
+ *
+ * @param x    Pointer to the sequence of tanh outputs whose gradient to use.
+ * @param y    Pointer to the sequence to multiply with the gradient.
+ * @param size The number of elements in each sequence.
+ ******************************************************************************/
+void tanhGradient(const float* x, float* y, const std::size_t size);
+
+/*******************************************************************************
+ * @brief Applies the hyperbolic tangent to a sequence with specified accuracy.
+ *        The approximations are clamped to +-1 and propagate NaN.
+ *
+ * @param x         Pointer to the sequence to apply the hyperbolic tangent to.
+ * @param y         Pointer to the sequence in which to store the result. 
+ *                  May be the same as x.
+ * @param size      The number of elements in each sequence.
+ * @param precision The accuracy tier to use, see enum class TanhPrecision.
+ ******************************************************************************/
+void tanh(const double* x, double* y, const std::size_t size, const TanhPrecision precision);
+
+/*******************************************************************************
+ * @brief Applies the hyperbolic tangent to a single-precision sequence with 
+ *        specified accuracy. The approximations are clamped to +-1 and 
+ *        propagate NaN.
+ *
+ * @param x         Pointer to the sequence to apply the hyperbolic tangent to.
+ * @param y         Pointer to the sequence in which to store the result. 
+ *                  May be the same as x.
+ * @param size      The number of elements in each sequence.
+ * @param precision The accuracy tier to use, see enum class TanhPrecision.
+ ******************************************************************************/
+void tanh(const float* x, float* y, const std::size_t size, const TanhPrecision precision);
+
+} // namespace kernels
+} // namespace ml
@@ -0,0 +1,39 @@
+/*******************************************************************************
+ * @brief Implementation of read-only files mapped into memory.
+ ******************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace ml
+{
+
+/*******************************************************************************
+ * @brief Structure holding a file mapped into memory.
+ *
+ *        The mapping is private and writable: modified pages are copied on
+ *        write and never written back to the file. The mapping is released
+ *        once the last copy of the storage pointer is destroyed.
+ ******************************************************************************/
+struct MappedFile
+{
+    std::shared_ptr<const void> storage; // Owner of the mapping.
+    char* data;                          // Pointer to the first byte of the file.
+    std::size_t size;                    // The size of the file in bytes.
+};
+
+/*******************************************************************************
+ * @brief Maps specified file into memory. Pages are read from disk once they
+ *        are first accessed.
+ *
+ * @param path        The path of the file to map.
+ * @param minimumSize The minimum size of a valid file in bytes, typically the
+ *                    size of its header.
+ *
+ * @return The mapped file.
+ ******************************************************************************/
+MappedFile mapFile(const std::string& path, const std::size_t minimumSize);
+
+} // namespace ml
@@ -0,0 +1,243 @@
+/*******************************************************************************
+ * @brief Implementation of contiguous row-major matrices.
+ ******************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "aligned_allocator.h"
+#include "span.h"
+
+namespace ml
+{
+
+/*******************************************************************************
+ * @brief Class implementation of row-major matrices stored in a single
+ *        contiguous, cache line aligned memory block.
+ *
+ *        Each row is padded to the stride of the matrix, so that every row
+ *        starts on an aligned address. The padding elements are always zero.
+ *
+ *        A matrix can also be created as a view of external memory with the
+ *        same layout, for instance the pages of a memory mapped model file.
+ *        The viewed memory is not owned and must outlive the matrix. Copies
+ *        of a view always own their elements.
+ *
+ * @tparam T The element type.
+ ******************************************************************************/
+template <typename T>
+class Matrix
+{
+public:
+
+    static constexpr std::size_t Alignment{64U}; // Alignment of each row in bytes.
+
+    /*******************************************************************************
+     * @brief The maximum number of columns, for which the size of a padded row
+     *        in bytes fits in std::size_t.
+     ******************************************************************************/
+    static constexpr std::size_t MaxColumnCount{
+        (std::numeric_limits<std::size_t>::max() - Alignment) / sizeof(T)};
+
+    /*******************************************************************************
+     * @brief Creates empty matrix.
+     ******************************************************************************/
+    Matrix() noexcept;
+
+    /*******************************************************************************
+     * @brief Creates new matrix.
+     *
+     * @param rowCount    The number of rows of the matrix.
+     * @param columnCount The number of columns of the matrix.
+     * @param startValue  The starting value of each element (default = 0).
+     ******************************************************************************/
+    Matrix(const std::size_t rowCount, const std::size_t columnCount,
+           const T startValue = T{});
+
+    /*******************************************************************************
+     * @brief Creates matrix viewing external memory without copying it.
+     *
+     * @param data        Pointer to the first element of the viewed memory, 
+     *                    which must be aligned to the alignment of the matrix.
+     * @param rowCount    The number of rows of the matrix.
+     * @param columnCount The number of columns of the matrix.
+     ******************************************************************************/
+    Matrix(T* data, const std::size_t rowCount, const std::size_t columnCount);
+
+    /*******************************************************************************
+     * @brief Creates matrix holding a copy of the elements of another matrix.
+     *
+     * @param other Reference to the matrix to copy.
+     ******************************************************************************/
+    Matrix(const Matrix& other);
+
+    /*******************************************************************************
+     * @brief Creates matrix by moving the content of another matrix.
+     *
+     * @param other Reference to the matrix to move.
+     ******************************************************************************/
+    Matrix(Matrix&& other) noexcept = default;
+
+    /*******************************************************************************
+     * @brief Deletes matrix.
+     ******************************************************************************/
+    ~Matrix() = default;
+
+    /*******************************************************************************
+     * @brief Assigns a copy of the elements of another matrix.
+     *
+     * @param other Reference to the matrix to copy.
+     *
+     * @return Reference to the matrix.
+     ******************************************************************************/
+    Matrix& operator=(const Matrix& other);
+
+    /*******************************************************************************
+     * @brief Moves the content of another matrix into the matrix.
+     *
+     * @param other Reference to the matrix to move.
+     *
+     * @return Reference to the matrix.
+     ******************************************************************************/
+    Matrix& operator=(Matrix&& other) noexcept = default;
+
+    /*******************************************************************************
+     * @brief Provides the number of rows of the matrix.
+     *
+     * @return The number of rows as an unsigned integer.
+     ******************************************************************************/
+    std::size_t rowCount() const noexcept;
+
+    /*******************************************************************************
+     * @brief Provides the number of columns of the matrix.
+     *
+     * @return The number of columns as an unsigned integer.
+     ******************************************************************************/
+    std::size_t columnCount() const noexcept;
+
+    /*******************************************************************************
+     * @brief Provides the distance between the start of two consecutive rows.
+     *
+     * @return The stride in number of elements as an unsigned integer.
+     ******************************************************************************/
+    std::size_t stride() const noexcept;
+
+    /*******************************************************************************
+     * @brief Indicates if the matrix is empty.
+     *
+     * @return True if the matrix is empty, else false.
+     ******************************************************************************/
+    bool empty() const noexcept;
+
+    /*******************************************************************************
+     * @brief Indicates if the matrix is a view of external memory.
+     *
+     * @return True if the matrix views external memory, else false.
+     ******************************************************************************/
+    bool isView() const noexcept;
+
+    /*******************************************************************************
+     * @brief Provides pointer to the first element of the matrix.
+     *
+     * @return Pointer to the first element.
+     ******************************************************************************/
+    T* data() noexcept;
+
+    /*******************************************************************************
+     * @brief Provides pointer to the first element of the matrix.
+     *
+     * @return Read-only pointer to the first element.
+     ******************************************************************************/
+    const T* data() const noexcept;
+
+    /*******************************************************************************
+     * @brief Provides view of specified row without bounds checking.
+     *
+     * @param index The index of the row.
+     *
+     * @return Span viewing the elements of the row (excluding padding).
+     ******************************************************************************/
+    Span<T> row(const std::size_t index) noexcept;
+
+    /*******************************************************************************
+     * @brief Provides read-only view of specified row without bounds checking.
+     *
+     * @param index The index of the row.
+     *
+     * @return Span viewing the elements of the row (excluding padding).
+     ******************************************************************************/
+    Span<const T> row(const std::size_t index) const noexcept;
+
+    /*******************************************************************************
+     * @brief Provides view of specified row without bounds checking.
+     *
+     * @param index The index of the row.
+     *
+     * @return Span viewing the elements of the row (excluding padding).
+     ******************************************************************************/
+    Span<T> operator[](const std::size_t index) noexcept;
+
+    /*******************************************************************************
+     * @brief Provides read-only view of specified row without bounds checking.
+     *
+     * @param index The index of the row.
+     *
+     * @return Span viewing the elements of the row (excluding padding).
+     ******************************************************************************/
+    Span<const T> operator[](const std::size_t index) const noexcept;
+
+    /*******************************************************************************
+     * @brief Resizes the matrix. Memory is only reallocated if the new size
+     *        exceeds the current capacity. A view is turned into an owning 
+     *        matrix, leaving the viewed memory unchanged.
+     *
+     * @param rowCount    The new number of rows.
+     * @param columnCount The new number of columns.
+     * @param startValue  The value to assign to each element (default = 0).
+     ******************************************************************************/
+    void resize(const std::size_t rowCount, const std::size_t columnCount,
+                const T startValue = T{});
+
+    /*******************************************************************************
+     * @brief Assigns specified value to each element of the matrix.
+     *
+     * @param value The value to assign.
+     ******************************************************************************/
+    void fill(const T value);
+
+    /*******************************************************************************
+     * @brief Prints the content of the matrix.
+     *
+     * @param ostream      Reference to output stream (default = terminal print).
+     * @param end          Ending characters (default = new line).
+     * @param decimalCount Number of decimals to print when using floating
+     *                     point numbers (default = 1).
+     ******************************************************************************/
+    void print(std::ostream& ostream = std::cout, const char* end = "\n",
+               const std::size_t decimalCount = 1U) const;
+
+    /*******************************************************************************
+     * @brief Provides the stride to use for specified number of columns.
+     *
+     * @param columnCount The number of columns.
+     *
+     * @return The stride in number of elements, or 0 if the number of columns
+     *         exceeds MaxColumnCount, in which case the stride would overflow.
+     ******************************************************************************/
+    static constexpr std::size_t strideFor(const std::size_t columnCount) noexcept;
+
+private:
+
+    std::vector<T, AlignedAllocator<T, Alignment>> myData; // Elements incl. padding.
+    T* myView;                                             // Viewed memory (if any).
+    std::size_t myRowCount;                                // The number of rows.
+    std::size_t myColumnCount;                             // The number of columns.
+    std::size_t myStride;                                  // Elements per padded row.
+};
+
+} // namespace ml
+
+#include "matrix_impl.h"
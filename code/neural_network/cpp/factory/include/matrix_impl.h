@@ -0,0 +1,197 @@
+/*******************************************************************************
+ * @brief Implementation details of the ml::Matrix class.
+ *
+ * @note Do not include this file in any application!
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#include "utils.h"
+
+namespace ml
+{
+
+// -----------------------------------------------------------------------------
+template <typename T>
+Matrix<T>::Matrix() noexcept
+    : myData{}
+    , myView{nullptr}
+    , myRowCount{0U}
+    , myColumnCount{0U}
+    , myStride{0U} {}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+Matrix<T>::Matrix(const std::size_t rowCount, const std::size_t columnCount,
+                  const T startValue)
+    : Matrix{}
+{
+    resize(rowCount, columnCount, startValue);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+Matrix<T>::Matrix(T* data, const std::size_t rowCount, const std::size_t columnCount)
+    : myData{}
+    , myView{data}
+    , myRowCount{rowCount}
+    , myColumnCount{columnCount}
+    , myStride{strideFor(columnCount)}
+{
+    if (columnCount > MaxColumnCount)
+    {
+        throw std::invalid_argument("Too many columns for matrix!");
+    }
+    if ((data == nullptr) && (rowCount > 0U) && (columnCount > 0U))
+    {
+        throw std::invalid_argument("Cannot create matrix viewing null!");
+    }
+    if ((reinterpret_cast<std::uintptr_t>(data) % Alignment) != 0U)
+    {
+        throw std::invalid_argument("Cannot create matrix viewing misaligned memory!");
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+Matrix<T>::Matrix(const Matrix& other)
+    : myData(other.data(), other.data() + other.myRowCount * other.myStride)
+    , myView{nullptr}
+    , myRowCount{other.myRowCount}
+    , myColumnCount{other.myColumnCount}
+    , myStride{other.myStride} {}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+Matrix<T>& Matrix<T>::operator=(const Matrix& other)
+{
+    if (this != &other)
+    {
+        myData.assign(other.data(), other.data() + other.myRowCount * other.myStride);
+        myView        = nullptr;
+        myRowCount    = other.myRowCount;
+        myColumnCount = other.myColumnCount;
+        myStride      = other.myStride;
+    }
+    return *this;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t Matrix<T>::rowCount() const noexcept { return myRowCount; }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t Matrix<T>::columnCount() const noexcept { return myColumnCount; }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t Matrix<T>::stride() const noexcept { return myStride; }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+bool Matrix<T>::empty() const noexcept { return myRowCount == 0U || myColumnCount == 0U; }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+bool Matrix<T>::isView() const noexcept { return myView != nullptr; }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+T* Matrix<T>::data() noexcept { return myView != nullptr ? myView : myData.data(); }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+const T* Matrix<T>::data() const noexcept 
+{ 
+    return myView != nullptr ? myView : myData.data(); 
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+Span<T> Matrix<T>::row(const std::size_t index) noexcept
+{
+    return Span<T>{data() + index * myStride, myColumnCount};
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+Span<const T> Matrix<T>::row(const std::size_t index) const noexcept
+{
+    return Span<const T>{data() + index * myStride, myColumnCount};
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+Span<T> Matrix<T>::operator[](const std::size_t index) noexcept { return row(index); }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+Span<const T> Matrix<T>::operator[](const std::size_t index) const noexcept
+{
+    return row(index);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void Matrix<T>::resize(const std::size_t rowCount, const std::size_t columnCount,
+                       const T startValue)
+{
+    if (columnCount > MaxColumnCount)
+    {
+        throw std::invalid_argument("Too many columns for matrix!");
+    }
+    myView        = nullptr;
+    myRowCount    = rowCount;
+    myColumnCount = columnCount;
+    myStride      = strideFor(columnCount);
+    myData.resize(myRowCount * myStride);
+    fill(startValue);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void Matrix<T>::fill(const T value)
+{
+    for (std::size_t i{}; i < myRowCount; ++i)
+    {
+        auto* const first{data() + i * myStride};
+        std::fill(first, first + myColumnCount, value);
+        std::fill(first + myColumnCount, first + myStride, T{});
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void Matrix<T>::print(std::ostream& ostream, const char* end,
+                      const std::size_t decimalCount) const
+{
+    ostream << "[";
+
+    for (std::size_t i{}; i < myRowCount; ++i)
+    {
+        const auto separator{i < myRowCount - 1U ? ", " : ""};
+        utils::vector::print<T>(row(i).data(), myColumnCount, ostream, separator, decimalCount);
+    }
+    ostream << "]";
+    if (end != nullptr) { ostream << end; }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+constexpr std::size_t Matrix<T>::strideFor(const std::size_t columnCount) noexcept
+{
+    if (columnCount > MaxColumnCount) { return 0U; }
+
+    if constexpr ((Alignment % sizeof(T)) == 0U)
+    {
+        constexpr auto elementsPerLine{Alignment / sizeof(T)};
+        return (columnCount + elementsPerLine - 1U) / elementsPerLine * elementsPerLine;
+    }
+    else { return columnCount; }
+}
+
+} // namespace ml
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * @brief Implementation of the binary model format, which is used to persist
+ *        trained neural networks.
+ ******************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "act_func.h"
+#include "neural_network_interface.h"
+#include "scalar_type.h"
+
+namespace ml
+{
+namespace model
+{
+
+/*******************************************************************************
+ * @brief Layout of the binary model format (all fields in native byte order):
+ *
+ *        - A ModelHeader at offset 0.
+ *        - One LayerRecord per layer, starting at offset sizeof(ModelHeader).
+ *        - The bias and weights of each layer at the offsets given by its
+ *          record. Each section starts on a SectionAlignment aligned offset,
+ *          and the weights use the padded row layout of ml::Matrix, so that
+ *          loaded weights can view the mapped file directly.
+ *
+ *        The checksum is the standard 64-bit FNV-1a hash of every byte 
+ *        following the header.
+ ******************************************************************************/
+constexpr char Magic[8U]{'M', 'L', 'M', 'O', 'D', 'E', 'L', '\0'}; // File signature.
+constexpr std::uint32_t Version{1U};                                 // Format version.
+constexpr std::size_t SectionAlignment{64U};                         // Section alignment.
+
+/*******************************************************************************
+ * @brief Structure holding the header of a model file.
+ ******************************************************************************/
+struct ModelHeader
+{
+    char magic[8U];            // File signature, see Magic.
+    std::uint32_t version;     // Format version, see Version.
+    ScalarType scalarType;     // Scalar type of the parameters.
+    std::uint32_t layerCount;  // Number of layer records (hidden and output layer).
+    std::uint32_t reserved;    // Reserved, always 0.
+    std::uint64_t fileSize;    // Total size of the file in bytes.
+    std::uint64_t checksum;    // Checksum of every byte following the header.
+    std::uint8_t padding[24U]; // Reserved, always 0.
+};
+
+/*******************************************************************************
+ * @brief Structure holding the topology and parameter offsets of a layer.
+ ******************************************************************************/
+struct LayerRecord
+{
+    std::uint64_t nodeCount;     // Number of nodes in the layer.
+    std::uint64_t weightCount;   // Number of weights per node.
+    std::uint64_t stride;        // Number of elements per padded weight row.
+    std::uint64_t biasOffset;    // File offset of the bias in bytes.
+    std::uint64_t weightOffset;  // File offset of the weights in bytes.
+    ActFunc actFunc;             // Activation function of the layer.
+    TanhPrecision tanhPrecision; // Accuracy of the hyperbolic tangent.
+};
+
+static_assert(sizeof(ModelHeader) == 64U, "Unexpected model header size!");
+static_assert(sizeof(LayerRecord) == 48U, "Unexpected layer record size!");
+
+/*******************************************************************************
+ * @brief Saves the parameters and topology of a neural network to a file.
+ *
+ * @tparam T The floating-point type of the parameters (default = double).
+ *
+ * @param network Reference to the neural network to save.
+ * @param path    The path of the model file. Any existing file is replaced.
+ ******************************************************************************/
+template <typename T = double>
+void save(const NeuralNetworkInterface<T>& network, const std::string& path);
+
+/*******************************************************************************
+ * @brief Loads a neural network from a model file. The file is memory mapped
+ *        and the weights of the layers view the mapped pages without being
+ *        copied, so pages are only read from disk once they are used. The
+ *        mapping is private: training the loaded network never modifies the
+ *        file. The header and layer records are always validated, while the
+ *        checksum is only verified on request, see verify.
+ *
+ * @tparam T The floating-point type of the parameters (default = double),
+ *           which must match the scalar type of the model file.
+ *
+ * @param path           The path of the model file.
+ * @param verifyChecksum Indicates if the checksum shall be verified, which
+ *                       reads the entire file before the network is used 
+ *                       (default = false).
+ *
+ * @return Pointer to the loaded neural network.
+ ******************************************************************************/
+template <typename T = double>
+std::unique_ptr<NeuralNetworkInterface<T>> load(const std::string& path,
+                                                const bool verifyChecksum = false);
+
+/*******************************************************************************
+ * @brief Verifies the header and checksum of a model file, which reads the 
+ *        entire file. Verify model files once, for instance when they are 
+ *        copied or deployed, so that loading them can stay lazy. An 
+ *        std::invalid_argument exception is thrown if the file is invalid.
+ *
+ * @param path The path of the model file.
+ ******************************************************************************/
+void verify(const std::string& path);
+
+} // namespace model
+} // namespace ml
@@ -3,13 +3,19 @@
  ******************************************************************************/
 #pragma once
 
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <vector>
 
 #include "act_func.h"
 #include "dense_layer_interface.h"
+#include "inference_context.h"
+#include "matrix.h"
 #include "neural_network_interface.h"
+#include "streaming_dataset.h"
+#include "training_data.h"
+#include "train_strategy.h"
 
 namespace ml
 {
@@ -17,9 +23,13 @@ namespace ml
 /*******************************************************************************
  * @brief Class implementation of neural networks with a single hidden layer.
  * 
- *        This class is non-copyable and non-movable.
+ *        This class is non-copyable and non-movable. Explicit instantiations
+ *        are provided for float and double.
+ * 
+ * @tparam T The floating-point type of the parameters (default = double).
  ******************************************************************************/
-class NeuralNetwork : public NeuralNetworkInterface
+template <typename T = double>
+class NeuralNetwork : public NeuralNetworkInterface<T>
 {
 public:
 
@@ -34,12 +44,29 @@ public:
      *                         (default = ReLU).
      * @param actFuncOutput    Activation function of the output layer 
      *                         (default = ReLU).
+     * @param tanhPrecision    The accuracy of the hyperbolic tangent in layers
+     *                         using tanh activation (default = exact).
      ******************************************************************************/
     NeuralNetwork(const std::size_t inputCount, 
                   const std::size_t hiddenNodesCount,
                   const std::size_t outputCount, 
                   const ActFunc actFuncHidden = ActFunc::Relu, 
-                  const ActFunc actFuncOutput = ActFunc::Relu);
+                  const ActFunc actFuncOutput = ActFunc::Relu,
+                  const TanhPrecision tanhPrecision = TanhPrecision::Exact);
+
+    /*******************************************************************************
+     * @brief Creates new neural network from existing layers, for instance 
+     *        layers loaded from a model file.
+     * 
+     * @param hiddenLayer Pointer to the hidden layer.
+     * @param outputLayer Pointer to the output layer, which must have one weight 
+     *                    per node in the hidden layer.
+     * @param storage     Memory viewed by the parameters of the layers, which is 
+     *                    kept alive by the network (default = none).
+     ******************************************************************************/
+    NeuralNetwork(std::unique_ptr<DenseLayerInterface<T>> hiddenLayer,
+                  std::unique_ptr<DenseLayerInterface<T>> outputLayer,
+                  std::shared_ptr<const void> storage = nullptr);
 
     /*******************************************************************************
      * @brief Deletes neural network.
@@ -67,19 +94,56 @@ public:
      ******************************************************************************/
     std::size_t outputCount() const override;
 
+    /*******************************************************************************
+     * @brief Provides the hidden layer of the neural network.
+     * 
+     * @return Reference to the hidden layer.
+     ******************************************************************************/
+    const DenseLayerInterface<T>& hiddenLayer() const override;
+
+    /*******************************************************************************
+     * @brief Provides the output layer of the neural network.
+     * 
+     * @return Reference to the output layer.
+     ******************************************************************************/
+    const DenseLayerInterface<T>& outputLayer() const override;
+
     /*******************************************************************************
      * @brief Provides the output of the neural network.
      * 
      * @return Reference to vector holding the output of the network.
      ******************************************************************************/
-    const std::vector<double>& output() const override;
+    const std::vector<T>& output() const override;
 
     /*******************************************************************************
      * @brief Provides the number of stored training sets.
      * 
      * @return The number of training sets as an integer.
      ******************************************************************************/
-    std::size_t trainingSetCount() const;
+    std::size_t trainingSetCount() const override;
+
+    /*******************************************************************************
+     * @brief Provides the input of the stored training sets.
+     * 
+     * @return Reference to matrix holding the input of each training set.
+     ******************************************************************************/
+    const Matrix<T>& trainingInput() const override;
+
+    /*******************************************************************************
+     * @brief Provides the output of the stored training sets.
+     * 
+     * @return Reference to matrix holding the output of each training set.
+     ******************************************************************************/
+    const Matrix<T>& trainingOutput() const override;
+
+    /*******************************************************************************
+     * @brief Provides the version of the network's parameters, which is 
+     *        incremented each time the parameters are optimized. Results 
+     *        computed for the same version are valid as long as it is unchanged.
+     * 
+     * @return The version as an unsigned integer.
+     ******************************************************************************/
+    std::size_t weightsVersion() const override;
 
     /*******************************************************************************
      * @brief Performs prediction based on given input.
@@ -88,16 +152,89 @@ public:
      * 
      * @return Reference to vector holding the predicted output.
      ******************************************************************************/
-    const std::vector<double>& predict(const std::vector<double>& input) override;
+    const std::vector<T>& predict(const std::vector<T>& input) override;
+
+    /*******************************************************************************
+     * @brief Performs prediction for a batch of inputs. Each layer is computed 
+     *        as one matrix-matrix product for the entire batch.
+     * 
+     * @param input  Reference to matrix holding one input per row.
+     * @param output Reference to matrix in which to store the predicted output,
+     *               one row per input. The matrix is resized if needed.
+     ******************************************************************************/
+    void predict(const Matrix<T>& input, Matrix<T>& output) override;
+
+    /*******************************************************************************
+     * @brief Performs prediction based on given input without modifying the 
+     *        neural network. Any number of threads can predict concurrently 
+     *        with one network, given that each thread uses its own context.
+     * 
+     * @param input   Reference to vector holding the input on which to predict.
+     * @param context Reference to the context holding the activation buffers 
+     *                to use. No memory is allocated once the context has been 
+     *                used with this network.
+     * 
+     * @return Reference to vector in the context holding the predicted output.
+     ******************************************************************************/
+    const std::vector<T>& predict(const std::vector<T>& input, 
+                                  InferenceContext<T>& context) const override;
+
+    /*******************************************************************************
+     * @brief Performs prediction for a batch of inputs without modifying the 
+     *        neural network, see predict(input, context).
+     * 
+     * @param input   Reference to matrix holding one input per row.
+     * @param output  Reference to matrix in which to store the predicted output,
+     *                one row per input. The matrix is resized if needed.
+     * @param context Reference to the context holding the activation buffers 
+     *                to use.
+     ******************************************************************************/
+    void predict(const Matrix<T>& input, Matrix<T>& output, 
+                 InferenceContext<T>& context) const override;
+
+    /*******************************************************************************
+     * @brief Enables or disables caching of the activation function gradients 
+     *        in the layers during the feedforward of training. Prediction never
+     *        fills the cache. Caching is enabled by default for new networks
+     *        and disabled for networks loaded from a model file.
+     * 
+     * @param enable True to enable gradient caching, false to disable it.
+     ******************************************************************************/
+    void setGradientCaching(const bool enable) override;
+
+    /*******************************************************************************
+     * @brief Enables or disables exact evaluation after training. By default,
+     *        training returns the accuracy of the last epoch, accumulated from 
+     *        the predictions computed for each training set before it updated 
+     *        the parameters. This requires no extra forward passes, but lags the
+     *        parameters as they change during the epoch. With exact evaluation,
+     *        the accuracy is instead measured by one more pass over the training
+     *        sets with the final parameters.
+     * 
+     * @param enable True to enable exact evaluation, false to disable it.
+     ******************************************************************************/
+    void setExactEvaluation(const bool enable) override;
 
     /*******************************************************************************
-     * @brief Adds sets of training data. 
+     * @brief Adds sets of training data. The training sets are copied into 
+     *        contiguous storage, see ml::TrainingData.
      *
      * @param trainingInput  Reference to vector holding values of the input sets.
      * @param trainingOutput Reference to vector holding values of the output sets.
      ******************************************************************************/
-    void addTrainingSets(const std::vector<std::vector<double>>& trainingInput,
-                         const std::vector<std::vector<double>>& trainingOutput) override;
+    void addTrainingSets(const std::vector<std::vector<T>>& trainingInput,
+                         const std::vector<std::vector<T>>& trainingOutput) override;
+
+    /*******************************************************************************
+     * @brief Adds sets of training data, for instance training data loaded from 
+     *        a memory mapped file. The training data is moved into the
+     *        network, so training reads the training sets directly from the
+     *        given data without copying it. Pass std::move(trainingData) to
+     *        hand over training data held in a variable.
+     *
+     * @param trainingData Reference to the training data to move into the network.
+     ******************************************************************************/
+    void addTrainingSets(TrainingData<T>&& trainingData) override;
 
     /*******************************************************************************
      * @brief Trains the neural network.
@@ -106,13 +243,68 @@ public:
      * @param learningRate The rate with witch to optimize the network parameters 
      *                     (default = 0.01).
      *
-     * @return The accuracy post training as a double in the range 0 - 1, which
-     *         corresponds to 0 - 100 %.
+     * @return The accuracy of the last epoch as a double in the range 0 - 1, 
+     *         which corresponds to 0 - 100 %, see setExactEvaluation.
+     ******************************************************************************/
+    double train(const std::size_t epochCount, const T learningRate = 0.01) override;
+
+    /*******************************************************************************
+     * @brief Trains the neural network with mini-batches. The gradients of each
+     *        batch are accumulated and applied as one averaged update per batch.
+     * 
+     *        With the synchronous strategy, each batch is split into one shard 
+     *        per thread. Each thread computes the gradients of its shard in its 
+     *        own scratch buffers, after which the gradients are summed in a fixed
+     *        order. Results are therefore reproducible for a given thread count.
+     * 
+     *        With the asynchronous strategy, the training sets of each epoch are
+     *        split into one shard per thread. Each thread trains on its shard 
+     *        batch by batch and updates the shared parameters without locks 
+     *        (Hogwild). Races between updates are tolerated, which means that 
+     *        results are not reproducible.
+     * 
+     *        The shards run as tasks on the shared thread pool, see 
+     *        utils::ThreadPool, so no threads are created per call and at most
+     *        as many shards run at a time as the pool has threads.
+     *
+     * @param epochCount   The number of epochs to perform training.
+     * @param learningRate The rate with witch to optimize the network parameters.
+     * @param batchSize    The number of training sets per batch.
+     * @param threadCount  The number of threads to use (default = 1).
+     * @param strategy     The strategy to use for training with multiple threads
+     *                     (default = synchronous).
+     *
+     * @return The accuracy of the last epoch as a double in the range 0 - 1, 
+     *         which corresponds to 0 - 100 %, see setExactEvaluation.
+     ******************************************************************************/
+    double train(const std::size_t epochCount, const T learningRate, 
+                 const std::size_t batchSize, const std::size_t threadCount = 1U,
+                 const TrainStrategy strategy = TrainStrategy::Synchronous) override;
+
+    /*******************************************************************************
+     * @brief Trains the neural network with mini-batches streamed from file, 
+     *        which enables training on datasets larger than memory. Each epoch 
+     *        is one pass over the dataset, starting from the beginning of the file.
+     *        The next chunks are read in the background while a batch is trained.
+     *
+     * @param dataset      Reference to the dataset to stream training sets from.
+     * @param epochCount   The number of epochs to perform training.
+     * @param learningRate The rate with witch to optimize the network parameters 
+     *                     (default = 0.01).
+     * @param batchSize    The number of training sets per batch (default = 1).
+     *
+     * @return The accuracy of the last epoch as a double in the range 0 - 1, 
+     *         which corresponds to 0 - 100 %. With exact evaluation, the accuracy
+     *         is measured by one more pass over the dataset.
      ******************************************************************************/
-    double train(const std::size_t epochCount, const double learningRate = 0.01) override;
+    double train(StreamingDataset<T>& dataset, const std::size_t epochCount, 
+                 const T learningRate = 0.01, const std::size_t batchSize = 1U) override;
 
     /*******************************************************************************
      * @brief Provides the accuracy of the network by using stored training data.
+     *        The predictions of the training sets are cached, so the accuracy is 
+     *        only recomputed after the parameters have been optimized. The 
+     *        training sets are then predicted in parallel, see evaluate.
      * 
      * @return The accuracy as a double in the range 0 - 1, which corresponds 
      *          to 0 - 100 %.
@@ -120,7 +312,32 @@ public:
     double accuracy() override;
 
     /*******************************************************************************
-     * @brief Prints training results.
+     * @brief Provides the accuracy of the network by using one pass over 
+     *        specified dataset, starting from the beginning of the file.
+     * 
+     * @param dataset Reference to the dataset to stream training sets from.
+     * 
+     * @return The accuracy as a double in the range 0 - 1, which corresponds 
+     *          to 0 - 100 %.
+     ******************************************************************************/
+    double accuracy(StreamingDataset<T>& dataset) override;
+
+    /*******************************************************************************
+     * @brief Provides the accuracy of the network on specified data sets, for 
+     *        instance a held-out validation set kept apart from the training sets.
+     *        The data sets are split between threads, each predicting its share 
+     *        in batches, and the errors of the threads are summed in order.
+     * 
+     * @param data Reference to the data sets to evaluate.
+     * 
+     * @return The accuracy as a double in the range 0 - 1, which corresponds 
+     *          to 0 - 100 %.
+     ******************************************************************************/
+    double evaluate(const TrainingData<T>& data) override;
+
+    /*******************************************************************************
+     * @brief Prints training results. The cached predictions of the training 
+     *        sets are reused, see accuracy.
      * 
      * @param ostream      Reference to output stream (default = terminal print).
      * @param decimalCount The number of decimals for which to print floats
@@ -137,54 +354,183 @@ public:
     
 private:
 
+    /*******************************************************************************
+     * @brief Structure holding scratch buffers used for batch training.
+     ******************************************************************************/
+    struct BatchBuffers
+    {
+        Matrix<T> input;                   // Input of each training set in the batch.
+        Matrix<T> reference;               // Reference of each training set in the batch.
+        Matrix<T> hiddenOutput;            // Hidden layer output per training set.
+        Matrix<T> hiddenError;             // Hidden layer error per training set.
+        Matrix<T> output;                  // Output layer output per training set.
+        Matrix<T> outputError;             // Output layer error per training set.
+        std::vector<T> hiddenBiasGradient; // Accumulated hidden bias gradients.
+        Matrix<T> hiddenWeightGradient;    // Accumulated hidden weight gradients.
+        std::vector<T> outputBiasGradient; // Accumulated output bias gradients.
+        Matrix<T> outputWeightGradient;    // Accumulated output weight gradients.
+        double errorSum;                   // Accumulated error of the trained sets.
+    };
+
     /*******************************************************************************
      * @brief Initializes the training order after adding training sets.
      ******************************************************************************/
     void initTrainingOrder();
 
+    /*******************************************************************************
+     * @brief Copies specified training set into the training set buffers.
+     * 
+     * @param index The index of the training set.
+     ******************************************************************************/
+    void loadTrainingSet(const std::size_t index);
+
     /*******************************************************************************
      * @brief Randomizes the order of the training sets for next epoch.
      ******************************************************************************/
     void randomizeTrainingOrder();
 
     /*******************************************************************************
-     * @brief Performs feedforward to calculate new output for each node.
+     * @brief Performs feedforward to calculate new output for each node ahead
+     *        of backpropagation, caching the activation function gradients.
      *   
      * @param input Reference to vector holding the network's current input.
      ******************************************************************************/
-    void feedforward(const std::vector<double>& input);
+    void feedforward(const std::vector<T>& input);
 
     /*******************************************************************************
-     * @brief Performs backpropagation to calculate new error for each node.
+     * @brief Performs backpropagation and optimization after feedforward. The 
+     *        error propagation to the hidden layer is fused with the update of 
+     *        the output layer, so that each weight row of the output layer is 
+     *        streamed from memory once per training set.
+     *
+     * @param input        Reference to vector holding the network's current input.
+     * @param reference    Reference to vector holding the network's current 
+     *                     reference values.
+     * @param learningRate The rate to adjust the network's parameters.
+     ******************************************************************************/
+    void backpropagateAndOptimize(const std::vector<T>& input, 
+                                  const std::vector<T>& reference, 
+                                  const T learningRate);
+
+    /*******************************************************************************
+     * @brief Performs one epoch of synchronous batch training.
      * 
-     * @param reference Reference to vector holding the network's current 
-     *                  reference values.
+     * @param learningRate The rate with which to optimize the parameters.
+     * @param batchSize    The number of training sets per batch.
+     * @param threadCount  The number of threads to use.
      ******************************************************************************/
-    void backpropagate(const std::vector<double>& reference);
+    void trainSynchronous(const T learningRate, const std::size_t batchSize, 
+                          const std::size_t threadCount);
 
     /*******************************************************************************
-     * @brief Performs optimization by adjusting the network's parameters.
-        
-     * @param input        Reference to vector holding the network's current input.
-     * @param learningRate The rate to adjust the network's parameters.
+     * @brief Performs one epoch of asynchronous lock-free batch training.
+     * 
+     * @param learningRate The rate with which to optimize the parameters.
+     * @param batchSize    The number of training sets per batch.
+     * @param threadCount  The number of threads to use.
+     ******************************************************************************/
+    void trainAsynchronous(const T learningRate, const std::size_t batchSize, 
+                           const std::size_t threadCount);
+
+    /*******************************************************************************
+     * @brief Provides the accuracy of the last epoch over the stored training
+     *        sets, measured by one more pass if exact evaluation is enabled.
+     * 
+     * @param errorSum The error accumulated over the training sets during the 
+     *                 last epoch.
+     * 
+     * @return The accuracy as a double in the range 0 - 1, which corresponds 
+     *          to 0 - 100 %, or 0 if no training sets have been added.
+     ******************************************************************************/
+    double epochAccuracy(const double errorSum);
+
+    /*******************************************************************************
+     * @brief Copies the training sets of a batch into the batch buffers.
+     * 
+     * @param buffers Reference to the batch buffers to fill.
+     * @param first   Index of the first training set of the batch in the 
+     *                training order.
+     * @param count   The number of training sets of the batch.
+     ******************************************************************************/
+    void loadBatch(BatchBuffers& buffers, const std::size_t first, 
+                   const std::size_t count) const;
+
+    /*******************************************************************************
+     * @brief Performs feedforward and backpropagation for the batch stored in 
+     *        specified buffers and accumulates the gradients as well as the error
+     *        of the predictions. The parameters of the network are left unchanged.
+     * 
+     * @param buffers Reference to the batch buffers holding the batch.
+     ******************************************************************************/
+    void computeGradients(BatchBuffers& buffers) const;
+
+    /*******************************************************************************
+     * @brief Sums the gradients of all workers into the buffers of the first 
+     *        worker. The rows are split between the threads, while the gradients
+     *        of each row are always summed in worker order.
+     * 
+     * @param workerCount The number of workers whose gradients to sum.
+     ******************************************************************************/
+    void reduceGradients(const std::size_t workerCount);
+
+    /*******************************************************************************
+     * @brief Optimizes the network's parameters with gradients accumulated 
+     *        in specified buffers.
+     * 
+     * @param buffers      Reference to the batch buffers holding the gradients.
+     * @param learningRate The rate with which to optimize the parameters.
+     ******************************************************************************/
+    void optimize(const BatchBuffers& buffers, const T learningRate);
+
+    /*******************************************************************************
+     * @brief Predicts specified data sets in batches split between threads, 
+     *        each using its own batch buffers as activation scratch.
+     * 
+     * @param input       Reference to matrix holding the input of each data set.
+     * @param reference   Reference to matrix holding the reference of each data set.
+     * @param predictions Reference to matrix in which to store the prediction of
+     *                    each data set. The matrix is resized to fit.
+     * 
+     * @return The sum of the absolute errors of all predictions as a double.
+     ******************************************************************************/
+    double predictInParallel(const Matrix<T>& input, const Matrix<T>& reference, 
+                             Matrix<T>& predictions);
+
+    /*******************************************************************************
+     * @brief Provides the predictions for the stored training sets. The training 
+     *        sets are predicted in batches, and the predictions are cached until 
+     *        the parameters are optimized or other training sets are added.
+     * 
+     * @return Reference to matrix holding the prediction of each training set.
      ******************************************************************************/
-    void optimize(const std::vector<double>& input, const double learningRate);
+    const Matrix<T>& trainingPredictions();
 
     /*******************************************************************************
-     * @brief Calculates the average error for given training set.
+     * @brief Calculates the average error for specified training set by using 
+     *        the cached predictions.
      *
-     * @param input     Reference to vector holding training set input.
-     * @param reference Reference to vector holding training set output.
+     * @param index The index of the training set.
      * 
      * @return The average error of given training set as a double.
      ******************************************************************************/
-    double averageError(const std::vector<double>& input, const std::vector<double>& reference);
+    double averageError(const std::size_t index);
 
-    std::unique_ptr<DenseLayerInterface> myHiddenLayer;       // Pointer to hidden layer.
-    std::unique_ptr<DenseLayerInterface> myOutputLayer;       // Pointer to output layer.
-    std::vector<std::size_t> myTrainingOrder;                 // Training order via index.
-    const std::vector<std::vector<double>>* myTrainingInput;  // Pointer to training input.
-    const std::vector<std::vector<double>>* myTrainingOutput; // Pointer to training output.
+    std::shared_ptr<const void> myStorage;                 // Memory viewed by the layers.
+    std::unique_ptr<DenseLayerInterface<T>> myHiddenLayer; // Pointer to hidden layer.
+    std::unique_ptr<DenseLayerInterface<T>> myOutputLayer; // Pointer to output layer.
+    std::vector<std::size_t> myTrainingOrder;              // Training order via index.
+    TrainingData<T> myTrainingData;                        // Stored training sets.
+    std::vector<T> myTrainingSetInput;                     // Input of current training set.
+    std::vector<T> myTrainingSetOutput;                    // Output of current training set.
+    std::vector<BatchBuffers> myBatchBuffers;              // Batch buffers per worker.
+    InferenceContext<T> myInferenceContext;                // Context of batch prediction.
+    std::vector<T> myHiddenError;                          // Error propagated to hidden layer.
+    bool myExactEvaluation;                                // Evaluate exactly after training.
+    std::atomic<std::size_t> myWeightsVersion;             // Version of the parameters.
+    Matrix<T> myPredictions;                               // Cached training set predictions.
+    Matrix<T> myEvaluationOutput;                          // Predictions of evaluated sets.
+    std::size_t myPredictionsVersion;                      // Parameter version of predictions.
+    bool myPredictionsCached;                              // Indicates if predictions are cached.
 };
 
 } // namespace ml
\ No newline at end of file
@@ -6,12 +6,22 @@
 #include <iostream>
 #include <vector>
 
+#include "dense_layer_interface.h"
+#include "inference_context.h"
+#include "matrix.h"
+#include "streaming_dataset.h"
+#include "training_data.h"
+#include "train_strategy.h"
+
 namespace ml
 {
 
 /*******************************************************************************
  * @brief Interface for dense layers in neural networks.
+ * 
+ * @tparam T The floating-point type of the parameters (default = double).
  ******************************************************************************/
+template <typename T = double>
 class NeuralNetworkInterface
 {
 public:
@@ -19,7 +29,7 @@ public:
     /*******************************************************************************
      * @brief Deletes neural network.
      ******************************************************************************/
-    NeuralNetworkInterface() = default;
+    virtual ~NeuralNetworkInterface() = default;
     
     /*******************************************************************************
      * @brief Provides the number of inputs in the neural network.
@@ -35,12 +45,56 @@ public:
      ******************************************************************************/
     virtual std::size_t outputCount() const = 0;
 
+    /*******************************************************************************
+     * @brief Provides the hidden layer of the neural network.
+     * 
+     * @return Reference to the hidden layer.
+     ******************************************************************************/
+    virtual const DenseLayerInterface<T>& hiddenLayer() const = 0;
+
+    /*******************************************************************************
+     * @brief Provides the output layer of the neural network.
+     * 
+     * @return Reference to the output layer.
+     ******************************************************************************/
+    virtual const DenseLayerInterface<T>& outputLayer() const = 0;
+
+    /*******************************************************************************
+     * @brief Provides the number of stored training sets.
+     * 
+     * @return The number of training sets as an integer.
+     ******************************************************************************/
+    virtual std::size_t trainingSetCount() const = 0;
+
+    /*******************************************************************************
+     * @brief Provides the input of the stored training sets.
+     * 
+     * @return Reference to matrix holding the input of each training set.
+     ******************************************************************************/
+    virtual const Matrix<T>& trainingInput() const = 0;
+
+    /*******************************************************************************
+     * @brief Provides the output of the stored training sets.
+     * 
+     * @return Reference to matrix holding the output of each training set.
+     ******************************************************************************/
+    virtual const Matrix<T>& trainingOutput() const = 0;
+
+    /*******************************************************************************
+     * @brief Provides the version of the network's parameters, which is 
+     *        incremented each time the parameters are optimized. Results 
+     *        computed for the same version are valid as long as it is unchanged.
+     * 
+     * @return The version as an unsigned integer.
+     ******************************************************************************/
+    virtual std::size_t weightsVersion() const = 0;
+
     /*******************************************************************************
      * @brief Provides the output of the neural network.
      * 
      * @return Reference to vector holding the output of the network.
      ******************************************************************************/
-    virtual const std::vector<double>& output() const = 0;
+    virtual const std::vector<T>& output() const = 0;
 
     /*******************************************************************************
      * @brief Performs prediction based on given input.
@@ -49,16 +103,89 @@ public:
      * 
      * @return Reference to vector holding the predicted output.
      ******************************************************************************/
-    virtual const std::vector<double>& predict(const std::vector<double>& input) = 0;
+    virtual const std::vector<T>& predict(const std::vector<T>& input) = 0;
+
+    /*******************************************************************************
+     * @brief Performs prediction for a batch of inputs. Each layer is computed 
+     *        as one matrix-matrix product for the entire batch.
+     * 
+     * @param input  Reference to matrix holding one input per row.
+     * @param output Reference to matrix in which to store the predicted output,
+     *               one row per input. The matrix is resized if needed.
+     ******************************************************************************/
+    virtual void predict(const Matrix<T>& input, Matrix<T>& output) = 0;
+
+    /*******************************************************************************
+     * @brief Performs prediction based on given input without modifying the 
+     *        neural network. Any number of threads can predict concurrently 
+     *        with one network, given that each thread uses its own context.
+     * 
+     * @param input   Reference to vector holding the input on which to predict.
+     * @param context Reference to the context holding the activation buffers 
+     *                to use. No memory is allocated once the context has been 
+     *                used with this network.
+     * 
+     * @return Reference to vector in the context holding the predicted output.
+     ******************************************************************************/
+    virtual const std::vector<T>& predict(const std::vector<T>& input, 
+                                          InferenceContext<T>& context) const = 0;
+
+    /*******************************************************************************
+     * @brief Performs prediction for a batch of inputs without modifying the 
+     *        neural network, see predict(input, context).
+     * 
+     * @param input   Reference to matrix holding one input per row.
+     * @param output  Reference to matrix in which to store the predicted output,
+     *                one row per input. The matrix is resized if needed.
+     * @param context Reference to the context holding the activation buffers 
+     *                to use.
+     ******************************************************************************/
+    virtual void predict(const Matrix<T>& input, Matrix<T>& output, 
+                         InferenceContext<T>& context) const = 0;
 
     /*******************************************************************************
-     * @brief Adds sets of training data. 
+     * @brief Enables or disables caching of the activation function gradients 
+     *        in the layers during the feedforward of training. Prediction never
+     *        fills the cache. Caching is enabled by default for new networks
+     *        and disabled for networks loaded from a model file.
+     * 
+     * @param enable True to enable gradient caching, false to disable it.
+     ******************************************************************************/
+    virtual void setGradientCaching(const bool enable) = 0;
+
+    /*******************************************************************************
+     * @brief Enables or disables exact evaluation after training. By default,
+     *        training returns the accuracy of the last epoch, accumulated from 
+     *        the predictions computed for each training set before it updated 
+     *        the parameters. This requires no extra forward passes, but lags the
+     *        parameters as they change during the epoch. With exact evaluation,
+     *        the accuracy is instead measured by one more pass over the training
+     *        sets with the final parameters.
+     * 
+     * @param enable True to enable exact evaluation, false to disable it.
+     ******************************************************************************/
+    virtual void setExactEvaluation(const bool enable) = 0;
+
+    /*******************************************************************************
+     * @brief Adds sets of training data. The training sets are copied into 
+     *        contiguous storage, see ml::TrainingData.
      *
      * @param trainingInput  Reference to vector holding values of the input sets.
      * @param trainingOutput Reference to vector holding values of the output sets.
      ******************************************************************************/
-    virtual void addTrainingSets(const std::vector<std::vector<double>>& trainingInput,
-                                 const std::vector<std::vector<double>>& trainingOutput) = 0;
+    virtual void addTrainingSets(const std::vector<std::vector<T>>& trainingInput,
+                                 const std::vector<std::vector<T>>& trainingOutput) = 0;
+
+    /*******************************************************************************
+     * @brief Adds sets of training data, for instance training data loaded from 
+     *        a memory mapped file. The training data is moved into the
+     *        network, so training reads the training sets directly from the
+     *        given data without copying it. Pass std::move(trainingData) to
+     *        hand over training data held in a variable.
+     *
+     * @param trainingData Reference to the training data to move into the network.
+     ******************************************************************************/
+    virtual void addTrainingSets(TrainingData<T>&& trainingData) = 0;
 
     /*******************************************************************************
      * @brief Trains the neural network.
@@ -67,10 +194,61 @@ public:
      * @param learningRate The rate with witch to optimize the network parameters 
      *                     (default = 0.01).
      *
-     * @return The accuracy post training as a double in the range 0 - 1, which
-     *         corresponds to 0 - 100 %.
+     * @return The accuracy of the last epoch as a double in the range 0 - 1, 
+     *         which corresponds to 0 - 100 %, see setExactEvaluation.
+     ******************************************************************************/
+    virtual double train(const std::size_t epochCount, const T learningRate = 0.01) = 0;
+
+    /*******************************************************************************
+     * @brief Trains the neural network with mini-batches. The gradients of each
+     *        batch are accumulated and applied as one averaged update per batch.
+     * 
+     *        With the synchronous strategy, each batch is split into one shard 
+     *        per thread. Each thread computes the gradients of its shard in its 
+     *        own scratch buffers, after which the gradients are summed in a fixed
+     *        order. Results are therefore reproducible for a given thread count.
+     * 
+     *        With the asynchronous strategy, the training sets of each epoch are
+     *        split into one shard per thread. Each thread trains on its shard 
+     *        batch by batch and updates the shared parameters without locks 
+     *        (Hogwild). Races between updates are tolerated, which means that 
+     *        results are not reproducible.
+     * 
+     *        The shards run as tasks on the shared thread pool, see 
+     *        utils::ThreadPool, so no threads are created per call and at most
+     *        as many shards run at a time as the pool has threads.
+     *
+     * @param epochCount   The number of epochs to perform training.
+     * @param learningRate The rate with witch to optimize the network parameters.
+     * @param batchSize    The number of training sets per batch.
+     * @param threadCount  The number of threads to use (default = 1).
+     * @param strategy     The strategy to use for training with multiple threads
+     *                     (default = synchronous).
+     *
+     * @return The accuracy of the last epoch as a double in the range 0 - 1, 
+     *         which corresponds to 0 - 100 %, see setExactEvaluation.
+     ******************************************************************************/
+    virtual double train(const std::size_t epochCount, const T learningRate, 
+                         const std::size_t batchSize, const std::size_t threadCount = 1U,
+                         const TrainStrategy strategy = TrainStrategy::Synchronous) = 0;
+
+    /*******************************************************************************
+     * @brief Trains the neural network with mini-batches streamed from file, 
+     *        which enables training on datasets larger than memory. Each epoch 
+     *        is one pass over the dataset, starting from the beginning of the file.
+     *
+     * @param dataset      Reference to the dataset to stream training sets from.
+     * @param epochCount   The number of epochs to perform training.
+     * @param learningRate The rate with witch to optimize the network parameters 
+     *                     (default = 0.01).
+     * @param batchSize    The number of training sets per batch (default = 1).
+     *
+     * @return The accuracy of the last epoch as a double in the range 0 - 1, 
+     *         which corresponds to 0 - 100 %. With exact evaluation, the accuracy
+     *         is measured by one more pass over the dataset.
      ******************************************************************************/
-    virtual double train(const std::size_t epochCount, const double learningRate = 0.01) = 0;
+    virtual double train(StreamingDataset<T>& dataset, const std::size_t epochCount, 
+                         const T learningRate = 0.01, const std::size_t batchSize = 1U) = 0;
 
     /*******************************************************************************
      * @brief Provides the accuracy of the network by using stored training data.
@@ -80,6 +258,30 @@ public:
      ******************************************************************************/
     virtual double accuracy() = 0;
 
+    /*******************************************************************************
+     * @brief Provides the accuracy of the network by using one pass over 
+     *        specified dataset, starting from the beginning of the file.
+     * 
+     * @param dataset Reference to the dataset to stream training sets from.
+     * 
+     * @return The accuracy as a double in the range 0 - 1, which corresponds 
+     *          to 0 - 100 %.
+     ******************************************************************************/
+    virtual double accuracy(StreamingDataset<T>& dataset) = 0;
+
+    /*******************************************************************************
+     * @brief Provides the accuracy of the network on specified data sets, for 
+     *        instance a held-out validation set kept apart from the training sets.
+     *        The data sets are split between threads, each predicting its share 
+     *        in batches, and the errors of the threads are summed in order.
+     * 
+     * @param data Reference to the data sets to evaluate.
+     * 
+     * @return The accuracy as a double in the range 0 - 1, which corresponds 
+     *          to 0 - 100 %.
+     ******************************************************************************/
+    virtual double evaluate(const TrainingData<T>& data) = 0;
+
     /*******************************************************************************
      * @brief Prints training results.
      * 
@@ -0,0 +1,204 @@
+/*******************************************************************************
+ * @brief Implementation of int8 quantized neural networks for inference.
+ ******************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "act_func_calc.h"
+#include "dense_layer_interface.h"
+#include "matrix.h"
+#include "neural_network_interface.h"
+
+namespace ml
+{
+
+/*******************************************************************************
+ * @brief Class implementation of post-training quantized neural networks with
+ *        a single hidden layer, which are used for inference only.
+ *
+ *        The weights of a trained network are quantized to 8-bit integers with
+ *        one symmetric scale per node (row), i.e. the zero-point is always 0.
+ *        The input of each layer is quantized in the same way with a scale
+ *        determined from the current input. Dot products are calculated with
+ *        32-bit integer accumulation, after which the sum is scaled back to
+ *        floating-point, the bias is added and the activation function is
+ *        applied in floating-point.
+ *
+ *        The quantized weights occupy one byte per weight, compared to four
+ *        bytes for float and eight bytes for double.
+ *
+ *        This class is non-copyable and non-movable. Explicit instantiations
+ *        are provided for float and double.
+ *
+ * @tparam T The floating-point type of the quantized network (default = double).
+ ******************************************************************************/
+template <typename T = double>
+class QuantizedNetwork
+{
+public:
+
+    /*******************************************************************************
+     * @brief Creates new quantized network from a trained neural network. The
+     *        neural network is left unchanged and is not referenced afterwards.
+     *
+     * @param network Reference to the trained neural network to quantize.
+     ******************************************************************************/
+    explicit QuantizedNetwork(const NeuralNetworkInterface<T>& network);
+
+    /*******************************************************************************
+     * @brief Deletes quantized network.
+     ******************************************************************************/
+    ~QuantizedNetwork() = default;
+
+    /*******************************************************************************
+     * @brief Provides the number of inputs in the quantized network.
+     *
+     * @return The number of inputs as an integer.
+     ******************************************************************************/
+    std::size_t inputCount() const;
+
+    /*******************************************************************************
+     * @brief Provides the number of nodes in the network's hidden layer.
+     *
+     * @return The number of hidden nodes as an integer.
+     ******************************************************************************/
+    std::size_t hiddenNodesCount() const;
+
+    /*******************************************************************************
+     * @brief Provides the number of outputs in the quantized network.
+     *
+     * @return The number of outputs as an integer.
+     ******************************************************************************/
+    std::size_t outputCount() const;
+
+    /*******************************************************************************
+     * @brief Provides the output of the quantized network.
+     *
+     * @return Reference to vector holding the output of the network.
+     ******************************************************************************/
+    const std::vector<T>& output() const;
+
+    /*******************************************************************************
+     * @brief Provides the number of bytes occupied by the quantized parameters,
+     *        i.e. the weights, the weight scales and the bias.
+     *
+     * @return The size of the quantized parameters in bytes.
+     ******************************************************************************/
+    std::size_t parameterSize() const;
+
+    /*******************************************************************************
+     * @brief Performs prediction based on given input.
+     *
+     * @param input Reference to vector holding the input on which to predict.
+     *
+     * @return Reference to vector holding the predicted output.
+     ******************************************************************************/
+    const std::vector<T>& predict(const std::vector<T>& input);
+
+    /*******************************************************************************
+     * @brief Provides the accuracy of the quantized network for given data sets.
+     *        The accuracy is calculated the same way as for the neural network.
+     *
+     * @param input  Reference to vector holding the input of each data set.
+     * @param output Reference to vector holding the output of each data set.
+     *
+     * @return The accuracy as a double in the range 0 - 1, which corresponds
+     *          to 0 - 100 %.
+     ******************************************************************************/
+    double accuracy(const std::vector<std::vector<T>>& input,
+                    const std::vector<std::vector<T>>& output);
+
+    /*******************************************************************************
+     * @brief Provides the accuracy of the quantized network for given data sets
+     *        stored one per row, such as the training sets of a neural network.
+     *
+     * @param input  Reference to matrix holding the input of each data set.
+     * @param output Reference to matrix holding the output of each data set.
+     *
+     * @return The accuracy as a double in the range 0 - 1, which corresponds
+     *          to 0 - 100 %.
+     ******************************************************************************/
+    double accuracy(const Matrix<T>& input, const Matrix<T>& output);
+
+    /*******************************************************************************
+     * @brief Provides the difference in accuracy between specified neural network
+     *        and the quantized network on the training sets of the neural network.
+     *
+     * @param network Reference to the neural network, typically the network
+     *                from which the quantized network was created.
+     *
+     * @return The accuracy of the quantized network subtracted by the accuracy of
+     *         the neural network. A negative value means that accuracy was lost.
+     ******************************************************************************/
+    double accuracyDelta(NeuralNetworkInterface<T>& network);
+
+    /*******************************************************************************
+     * @brief Prints the accuracy of the quantized network compared to specified
+     *        neural network along with the predictions for each training set.
+     *
+     * @param network      Reference to the neural network, typically the network
+     *                     from which the quantized network was created.
+     * @param ostream      Reference to output stream (default = terminal print).
+     * @param decimalCount The number of decimals for which to print floats
+     *                     (default = 1).
+     ******************************************************************************/
+    void printResults(NeuralNetworkInterface<T>& network, std::ostream& ostream = std::cout,
+                      const std::size_t decimalCount = 1U);
+
+    QuantizedNetwork()                                   = delete; // No default constructor.
+    QuantizedNetwork(const QuantizedNetwork&)            = delete; // No copy constructor.
+    QuantizedNetwork(QuantizedNetwork&&)                 = delete; // No move constructor.
+    QuantizedNetwork& operator=(const QuantizedNetwork&) = delete; // No copy assignment.
+    QuantizedNetwork& operator=(QuantizedNetwork&&)      = delete; // No move assignment.
+
+private:
+
+    /*******************************************************************************
+     * @brief Structure holding the quantized parameters of a dense layer.
+     ******************************************************************************/
+    struct QuantizedLayer
+    {
+        Matrix<std::int8_t> weights;                 // Quantized weights (one row per node).
+        std::vector<T> weightScale;                  // Scale of the weights of each node.
+        std::vector<T> bias;                         // Bias of each node (not quantized).
+        std::vector<T> output;                       // Output of each node.
+        std::unique_ptr<ActFuncCalc<T>> actFuncCalc; // Activation function calculator.
+    };
+
+    /*******************************************************************************
+     * @brief Quantizes the parameters of specified dense layer.
+     *
+     * @param layer     Reference to the dense layer to quantize.
+     * @param quantized Reference to the quantized layer in which to store the
+     *                  quantized parameters.
+     ******************************************************************************/
+    static void quantize(const DenseLayerInterface<T>& layer, QuantizedLayer& quantized);
+
+    /*******************************************************************************
+     * @brief Performs feedforward for specified quantized layer.
+     *
+     * @param layer Reference to the quantized layer.
+     * @param input Reference to vector holding the input of the layer.
+     ******************************************************************************/
+    void feedforward(QuantizedLayer& layer, const std::vector<T>& input);
+
+    /*******************************************************************************
+     * @brief Calculates the average error for given data set.
+     *
+     * @param input     Reference to vector holding data set input.
+     * @param reference Reference to vector holding data set output.
+     *
+     * @return The average error of given data set as a double.
+     ******************************************************************************/
+    double averageError(const std::vector<T>& input, const std::vector<T>& reference);
+
+    QuantizedLayer myHiddenLayer;          // Quantized hidden layer.
+    QuantizedLayer myOutputLayer;          // Quantized output layer.
+    std::vector<std::int8_t> myLayerInput; // Quantized input of the current layer.
+};
+
+} // namespace ml
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * @brief Implementation of a fast seedable pseudo-random number generator.
+ ******************************************************************************/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace utils
+{
+
+/*******************************************************************************
+ * @brief Class implementation of the xoshiro256** pseudo-random number
+ *        generator, which produces 64-bit numbers from 256 bits of state.
+ *
+ *        Each thread uses its own generator, see local, so that no state is
+ *        shared between threads. The generators of all threads derive from one
+ *        seed: the generator of stream k is the generator of the seed advanced
+ *        by k * 2^128 numbers, so the streams never overlap in practice.
+ *
+ *        The class satisfies the requirements of a uniform random bit generator
+ *        and can thereby be used with the distributions of the standard library.
+ ******************************************************************************/
+class RandomGenerator
+{
+public:
+
+    using result_type = std::uint64_t; // The type of generated numbers.
+
+    /*******************************************************************************
+     * @brief Creates new generator. The state is expanded from the seed with
+     *        SplitMix64 as recommended for xoshiro generators.
+     *
+     * @param seed The seed of the generator.
+     ******************************************************************************/
+    explicit RandomGenerator(const std::uint64_t seed) noexcept;
+
+    /*******************************************************************************
+     * @brief Provides the generator of the calling thread. Each thread is
+     *        assigned the next stream of the current seed on first use, or on
+     *        first use after the seed has been changed.
+     *
+     * @return Reference to the generator of the calling thread.
+     ******************************************************************************/
+    static RandomGenerator& local();
+
+    /*******************************************************************************
+     * @brief Sets the seed of the generators of all threads. The calling thread
+     *        is assigned the first stream immediately, so that a single-threaded
+     *        program produces the same numbers for the same seed. Without a
+     *        seed, a random seed is used.
+     *
+     * @param seed The new seed.
+     ******************************************************************************/
+    static void seed(const std::uint64_t seed);
+
+    /*******************************************************************************
+     * @brief Provides the smallest number the generator can produce.
+     *
+     * @return The smallest number as an unsigned integer.
+     ******************************************************************************/
+    static constexpr result_type min() noexcept { return 0U; }
+
+    /*******************************************************************************
+     * @brief Provides the largest number the generator can produce.
+     *
+     * @return The largest number as an unsigned integer.
+     ******************************************************************************/
+    static constexpr result_type max() noexcept
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /*******************************************************************************
+     * @brief Generates the next number.
+     *
+     * @return The generated number as a 64-bit unsigned integer.
+     ******************************************************************************/
+    result_type operator()() noexcept;
+
+    /*******************************************************************************
+     * @brief Generates an unbiased number in the range [0, bound) with Lemire's
+     *        multiply-and-reject method, which rarely needs more than one number.
+     *
+     * @param bound The upper bound of the range (excluded), which must exceed 0.
+     *
+     * @return The generated number as a 64-bit unsigned integer.
+     ******************************************************************************/
+    std::uint64_t bounded(const std::uint64_t bound) noexcept;
+
+    /*******************************************************************************
+     * @brief Generates a uniformly distributed number in specified range. The
+     *        range is [min, max] for integral types and [min, max) for
+     *        floating-point types.
+     *
+     * @tparam T The arithmetic type of the number to generate.
+     *
+     * @param min The minimum number.
+     * @param max The maximum number.
+     *
+     * @return The generated number.
+     ******************************************************************************/
+    template <typename T>
+    T uniform(const T min, const T max) noexcept;
+
+    /*******************************************************************************
+     * @brief Advances the generator by 2^128 numbers, which is used to create
+     *        non-overlapping streams.
+     ******************************************************************************/
+    void jump() noexcept;
+
+private:
+
+    std::array<std::uint64_t, 4U> myState; // The state of the generator.
+};
+
+} // namespace utils
+
+#include "random_generator_impl.h"
@@ -0,0 +1,35 @@
+/*******************************************************************************
+ * @brief Implementation details of the utils::RandomGenerator class.
+ *
+ * @note Do not include this file in any application!
+ ******************************************************************************/
+#pragma once
+
+#include <type_traits>
+
+namespace utils
+{
+
+// -----------------------------------------------------------------------------
+template <typename T>
+T RandomGenerator::uniform(const T min, const T max) noexcept
+{
+    static_assert(std::is_arithmetic<T>::value,
+        "Non-arithmetic type selected for new random number!");
+
+    if constexpr (std::is_integral<T>::value)
+    {
+        // The range wraps to 0 if it spans every 64-bit number.
+        const auto range{static_cast<std::uint64_t>(max) - static_cast<std::uint64_t>(min) + 1U};
+        const auto offset{range == 0U ? (*this)() : bounded(range)};
+        return static_cast<T>(static_cast<std::uint64_t>(min) + offset);
+    }
+    else
+    {
+        // The upper 53 bits form a double in [0, 1) with every value equally likely.
+        const auto unit{static_cast<double>((*this)() >> 11U) * 0x1.0p-53};
+        return static_cast<T>(min + unit * (max - min));
+    }
+}
+
+} // namespace utils
@@ -0,0 +1,36 @@
+/*******************************************************************************
+ * @brief Implementation of scalar types stored in binary files.
+ ******************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace ml
+{
+
+/*******************************************************************************
+ * @brief Enum representing the scalar type of the values in a binary file.
+ ******************************************************************************/
+enum class ScalarType : std::uint32_t
+{
+    Float32 = 1U, // 32-bit floating-point numbers.
+    Float64 = 2U, // 64-bit floating-point numbers.
+};
+
+/*******************************************************************************
+ * @brief Provides the scalar type corresponding to specified type.
+ *
+ * @tparam T The floating-point type (float or double).
+ *
+ * @return The corresponding scalar type.
+ ******************************************************************************/
+template <typename T>
+constexpr ScalarType scalarType() noexcept
+{
+    static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value,
+        "Scalar types are only available for float and double!");
+    return std::is_same<T, float>::value ? ScalarType::Float32 : ScalarType::Float64;
+}
+
+} // namespace ml
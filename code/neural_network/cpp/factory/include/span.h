@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * @brief Implementation of lightweight views of contiguous sequences.
+ ******************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace ml
+{
+
+/*******************************************************************************
+ * @brief Non-owning view of a contiguous sequence of elements, such as a
+ *        vector or a row of a matrix.
+ *
+ *        A span is cheap to copy and should be passed by value.
+ *
+ * @tparam T The element type (const-qualify for read-only views).
+ ******************************************************************************/
+template <typename T>
+class Span
+{
+public:
+
+    /*******************************************************************************
+     * @brief Creates empty span.
+     ******************************************************************************/
+    constexpr Span() noexcept
+        : myData{nullptr}
+        , mySize{0U} {}
+
+    /*******************************************************************************
+     * @brief Creates span viewing specified sequence.
+     *
+     * @param data Pointer to the first element of the sequence.
+     * @param size The number of elements in the sequence.
+     ******************************************************************************/
+    constexpr Span(T* data, const std::size_t size) noexcept
+        : myData{data}
+        , mySize{size} {}
+
+    /*******************************************************************************
+     * @brief Creates read-only span viewing the content of specified vector.
+     *
+     * @param vector Reference to the vector to view.
+     ******************************************************************************/
+    template <typename U, typename Allocator,
+              typename = std::enable_if_t<std::is_same<const U, T>::value>>
+    Span(const std::vector<U, Allocator>& vector) noexcept
+        : myData{vector.data()}
+        , mySize{vector.size()} {}
+
+    /*******************************************************************************
+     * @brief Creates read-only span from a mutable span.
+     *
+     * @param other The span to view.
+     ******************************************************************************/
+    template <typename U,
+              typename = std::enable_if_t<std::is_same<const U, T>::value>>
+    constexpr Span(const Span<U>& other) noexcept
+        : myData{other.data()}
+        , mySize{other.size()} {}
+
+    /*******************************************************************************
+     * @brief Provides pointer to the first element of the span.
+     *
+     * @return Pointer to the first element.
+     ******************************************************************************/
+    constexpr T* data() const noexcept { return myData; }
+
+    /*******************************************************************************
+     * @brief Provides the number of elements of the span.
+     *
+     * @return The number of elements as an unsigned integer.
+     ******************************************************************************/
+    constexpr std::size_t size() const noexcept { return mySize; }
+
+    /*******************************************************************************
+     * @brief Indicates if the span is empty.
+     *
+     * @return True if the span is empty, else false.
+     ******************************************************************************/
+    constexpr bool empty() const noexcept { return mySize == 0U; }
+
+    /*******************************************************************************
+     * @brief Provides reference to element at specified index without bounds
+     *        checking.
+     *
+     * @param index The index of the element.
+     *
+     * @return Reference to the element.
+     ******************************************************************************/
+    constexpr T& operator[](const std::size_t index) const noexcept { return myData[index]; }
+
+    /*******************************************************************************
+     * @brief Provides pointer to the first element (for range-based loops).
+     ******************************************************************************/
+    constexpr T* begin() const noexcept { return myData; }
+
+    /*******************************************************************************
+     * @brief Provides pointer one past the last element (for range-based loops).
+     ******************************************************************************/
+    constexpr T* end() const noexcept { return myData + mySize; }
+
+    /*******************************************************************************
+     * @brief Copies the content of the span to a new vector.
+     *
+     * @return Vector holding a copy of the viewed elements.
+     ******************************************************************************/
+    std::vector<std::remove_const_t<T>> toVector() const
+    {
+        return std::vector<std::remove_const_t<T>>(begin(), end());
+    }
+
+private:
+    T* myData;          // Pointer to the first viewed element.
+    std::size_t mySize; // The number of viewed elements.
+};
+
+} // namespace ml
@@ -0,0 +1,213 @@
+/*******************************************************************************
+ * @brief Implementation of neural networks with topology known at compile time.
+ ******************************************************************************/
+#pragma once
+
+#include <array>
+#include <iostream>
+#include <vector>
+
+#include "act_func.h"
+
+namespace ml
+{
+
+/*******************************************************************************
+ * @brief Class implementation of neural networks with a single hidden layer,
+ *        where the number of nodes and the activation functions of each layer
+ *        are template parameters.
+ *
+ *        All parameters are stored in std::array, so the network performs no
+ *        heap allocations and no virtual calls during prediction. This enables
+ *        the compiler to fully unroll and inline small networks, which makes
+ *        this class suitable for tiny models where the topology is known at
+ *        compile time. Use factory::neuralNetwork for topologies determined
+ *        at runtime.
+ *
+ * @tparam InputCount    The number of inputs in the neural network.
+ * @tparam HiddenCount   The number of nodes in the network's hidden layer.
+ * @tparam OutputCount   The number of outputs in the neural network.
+ * @tparam ActFuncHidden Activation function of the hidden layer (default = ReLU).
+ * @tparam ActFuncOutput Activation function of the output layer (default = ReLU).
+ ******************************************************************************/
+template <std::size_t InputCount, std::size_t HiddenCount, std::size_t OutputCount,
+          ActFunc ActFuncHidden = ActFunc::Relu, ActFunc ActFuncOutput = ActFunc::Relu>
+class StaticNeuralNetwork
+{
+    static_assert((InputCount > 0U) && (HiddenCount > 0U) && (OutputCount > 0U),
+        "Cannot create neural network with empty layers!");
+    static_assert((ActFuncHidden < ActFunc::Count) && (ActFuncOutput < ActFunc::Count),
+        "Invalid activation function!");
+
+public:
+    using Input  = std::array<double, InputCount>;  // Input of the network.
+    using Output = std::array<double, OutputCount>; // Output of the network.
+
+    /*******************************************************************************
+     * @brief Creates new neural network with randomly initialized parameters.
+     ******************************************************************************/
+    StaticNeuralNetwork();
+
+    /*******************************************************************************
+     * @brief Deletes neural network.
+     ******************************************************************************/
+    ~StaticNeuralNetwork() = default;
+
+    /*******************************************************************************
+     * @brief Provides the number of inputs in the neural network.
+     *
+     * @return The number of inputs as an integer.
+     ******************************************************************************/
+    static constexpr std::size_t inputCount() { return InputCount; }
+
+    /*******************************************************************************
+     * @brief Provides the number of nodes in the network's hidden layer.
+     *
+     * @return The number of hidden nodes as an integer.
+     ******************************************************************************/
+    static constexpr std::size_t hiddenNodesCount() { return HiddenCount; }
+
+    /*******************************************************************************
+     * @brief Provides the number of outputs in the neural network.
+     *
+     * @return The number of outputs as an integer.
+     ******************************************************************************/
+    static constexpr std::size_t outputCount() { return OutputCount; }
+
+    /*******************************************************************************
+     * @brief Provides the output of the neural network.
+     *
+     * @return Reference to array holding the output of the network.
+     ******************************************************************************/
+    const Output& output() const;
+
+    /*******************************************************************************
+     * @brief Provides the number of stored training sets.
+     *
+     * @return The number of training sets as an integer.
+     ******************************************************************************/
+    std::size_t trainingSetCount() const;
+
+    /*******************************************************************************
+     * @brief Performs prediction based on given input.
+     *
+     * @param input Reference to array holding the input on which to predict.
+     *
+     * @return Reference to array holding the predicted output.
+     ******************************************************************************/
+    const Output& predict(const Input& input);
+
+    /*******************************************************************************
+     * @brief Adds sets of training data. The training sets are copied, so the
+     *        given vectors may be destroyed afterwards.
+     *
+     * @param trainingInput  Reference to vector holding values of the input sets.
+     * @param trainingOutput Reference to vector holding values of the output sets.
+     ******************************************************************************/
+    void addTrainingSets(const std::vector<Input>& trainingInput,
+                         const std::vector<Output>& trainingOutput);
+
+    /*******************************************************************************
+     * @brief Trains the neural network.
+     *
+     * @param epochCount   The number of epochs to perform training.
+     * @param learningRate The rate with witch to optimize the network parameters
+     *                     (default = 0.01).
+     *
+     * @return The accuracy post training as a double in the range 0 - 1, which
+     *         corresponds to 0 - 100 %.
+     ******************************************************************************/
+    double train(const std::size_t epochCount, const double learningRate = 0.01);
+
+    /*******************************************************************************
+     * @brief Provides the accuracy of the network by using stored training data.
+     *
+     * @return The accuracy as a double in the range 0 - 1, which corresponds
+     *          to 0 - 100 %.
+     ******************************************************************************/
+    double accuracy();
+
+    /*******************************************************************************
+     * @brief Prints training results.
+     *
+     * @param ostream      Reference to output stream (default = terminal print).
+     * @param decimalCount The number of decimals for which to print floats
+     *                     (default = 1).
+     ******************************************************************************/
+    void printResults(std::ostream& ostream = std::cout, const std::size_t decimalCount = 1U);
+
+private:
+
+    /*******************************************************************************
+     * @brief Provides the output of specified activation function.
+     *
+     * @tparam Func The activation function.
+     *
+     * @param number The input of the activation function.
+     *
+     * @return The activation function output as a double.
+     ******************************************************************************/
+    template <ActFunc Func>
+    static double activation(const double number);
+
+    /*******************************************************************************
+     * @brief Provides the gradient of specified activation function.
+     *
+     * @tparam Func The activation function.
+     *
+     * @param number The output of the activation function.
+     *
+     * @return The activation function gradient as a double.
+     ******************************************************************************/
+    template <ActFunc Func>
+    static double gradient(const double number);
+
+    /*******************************************************************************
+     * @brief Performs feedforward to calculate new output for each node.
+     *
+     * @param input Reference to array holding the network's current input.
+     ******************************************************************************/
+    void feedforward(const Input& input);
+
+    /*******************************************************************************
+     * @brief Performs backpropagation to calculate new error for each node.
+     *
+     * @param reference Reference to array holding the network's current
+     *                  reference values.
+     ******************************************************************************/
+    void backpropagate(const Output& reference);
+
+    /*******************************************************************************
+     * @brief Performs optimization by adjusting the network's parameters.
+     *
+     * @param input        Reference to array holding the network's current input.
+     * @param learningRate The rate to adjust the network's parameters.
+     ******************************************************************************/
+    void optimize(const Input& input, const double learningRate);
+
+    /*******************************************************************************
+     * @brief Calculates the average error for given training set.
+     *
+     * @param input     Reference to array holding training set input.
+     * @param reference Reference to array holding training set output.
+     *
+     * @return The average error of given training set as a double.
+     ******************************************************************************/
+    double averageError(const Input& input, const Output& reference);
+
+    std::array<double, HiddenCount> myHiddenOutput;                           // Hidden output.
+    std::array<double, HiddenCount> myHiddenError;                            // Hidden error.
+    std::array<double, HiddenCount> myHiddenBias;                             // Hidden bias.
+    std::array<std::array<double, InputCount>, HiddenCount> myHiddenWeights;  // Hidden weights.
+    Output myOutput;                                                          // Output.
+    std::array<double, OutputCount> myOutputError;                            // Output error.
+    std::array<double, OutputCount> myOutputBias;                             // Output bias.
+    std::array<std::array<double, HiddenCount>, OutputCount> myOutputWeights; // Output weights.
+    std::vector<std::size_t> myTrainingOrder;                                 // Training order.
+    std::vector<Input> myTrainingInput;                                       // Training input.
+    std::vector<Output> myTrainingOutput;                                     // Training output.
+};
+
+} // namespace ml
+
+#include "static_neural_network_impl.h"
@@ -0,0 +1,288 @@
+/*******************************************************************************
+ * @brief Implementation details of the ml::StaticNeuralNetwork class.
+ *
+ * @note Do not include this file in any application!
+ ******************************************************************************/
+#pragma once
+
+#include <iomanip>
+#include <stdexcept>
+
+#include "utils.h"
+
+namespace ml
+{
+
+// -----------------------------------------------------------------------------
+template <std::size_t InputCount, std::size_t HiddenCount, std::size_t OutputCount,
+          ActFunc ActFuncHidden, ActFunc ActFuncOutput>
+StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, ActFuncHidden, ActFuncOutput>
+    ::StaticNeuralNetwork()
+    : myHiddenOutput{}
+    , myHiddenError{}
+    , myHiddenBias{}
+    , myHiddenWeights{}
+    , myOutput{}
+    , myOutputError{}
+    , myOutputBias{}
+    , myOutputWeights{}
+    , myTrainingOrder{}
+    , myTrainingInput{}
+    , myTrainingOutput{}
+{
+    for (std::size_t i{}; i < HiddenCount; ++i)
+    {
+        myHiddenBias[i] = utils::random::getNumber<double>(0.0, 1.0);
+        for (auto& weight : myHiddenWeights[i]) 
+        { 
+            weight = utils::random::getNumber<double>(0.0, 1.0); 
+        }
+    }
+    for (std::size_t i{}; i < OutputCount; ++i)
+    {
+        myOutputBias[i] = utils::random::getNumber<double>(0.0, 1.0);
+        for (auto& weight : myOutputWeights[i]) 
+        { 
+            weight = utils::random::getNumber<double>(0.0, 1.0); 
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <std::size_t InputCount, std::size_t HiddenCount, std::size_t OutputCount,
+          ActFunc ActFuncHidden, ActFunc ActFuncOutput>
+const typename StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, 
+                                   ActFuncHidden, ActFuncOutput>::Output& 
+    StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, ActFuncHidden, ActFuncOutput>
+    ::output() const
+{
+    return myOutput;
+}
+
+// -----------------------------------------------------------------------------
+template <std::size_t InputCount, std::size_t HiddenCount, std::size_t OutputCount,
+          ActFunc ActFuncHidden, ActFunc ActFuncOutput>
+std::size_t StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, 
+                                ActFuncHidden, ActFuncOutput>::trainingSetCount() const
+{
+    return myTrainingOrder.size();
+}
+
+// -----------------------------------------------------------------------------
+template <std::size_t InputCount, std::size_t HiddenCount, std::size_t OutputCount,
+          ActFunc ActFuncHidden, ActFunc ActFuncOutput>
+const typename StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, 
+                                   ActFuncHidden, ActFuncOutput>::Output& 
+    StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, ActFuncHidden, ActFuncOutput>
+    ::predict(const Input& input)
+{
+    feedforward(input);
+    return myOutput;
+}
+
+// -----------------------------------------------------------------------------
+template <std::size_t InputCount, std::size_t HiddenCount, std::size_t OutputCount,
+          ActFunc ActFuncHidden, ActFunc ActFuncOutput>
+void StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, ActFuncHidden, ActFuncOutput>
+    ::addTrainingSets(const std::vector<Input>& trainingInput,
+                      const std::vector<Output>& trainingOutput)
+{
+    if (trainingInput.size() != trainingOutput.size())
+    {
+        throw(std::invalid_argument("Mismatching training sets!"));
+    }
+    if (trainingInput.empty())
+    {
+        throw(std::invalid_argument("Training sets missing!"));
+    }
+    myTrainingInput  = trainingInput;
+    myTrainingOutput = trainingOutput;
+    myTrainingOrder.resize(trainingInput.size());
+
+    for (std::size_t i{}; i < myTrainingOrder.size(); ++i) { myTrainingOrder[i] = i; }
+}
+
+// -----------------------------------------------------------------------------
+template <std::size_t InputCount, std::size_t HiddenCount, std::size_t OutputCount,
+          ActFunc ActFuncHidden, ActFunc ActFuncOutput>
+double StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, ActFuncHidden, ActFuncOutput>
+    ::train(const std::size_t epochCount, const double learningRate)
+{
+    if (epochCount == 0U)
+    {
+        throw(std::invalid_argument("Invalid epoch count 0!"));
+    }
+    if (learningRate <= 0)
+    {
+        throw(std::invalid_argument("Invalid learning rate <= 0!"));
+    }
+
+    for (std::size_t epoch{}; epoch < epochCount; ++epoch)
+    {
+        utils::vector::shuffle(myTrainingOrder);
+
+        for (const auto& i : myTrainingOrder)
+        {
+            feedforward(myTrainingInput[i]);
+            backpropagate(myTrainingOutput[i]);
+            optimize(myTrainingInput[i], learningRate);
+        }
+    }
+    return accuracy();
+}
+
+// -----------------------------------------------------------------------------
+template <std::size_t InputCount, std::size_t HiddenCount, std::size_t OutputCount,
+          ActFunc ActFuncHidden, ActFunc ActFuncOutput>
+double StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, ActFuncHidden, ActFuncOutput>
+    ::accuracy()
+{
+    if (trainingSetCount() == 0U) { return 0.0; }
+    double sum{};
+
+    for (std::size_t i{}; i < trainingSetCount(); ++i)
+    {
+        sum += averageError(myTrainingInput[i], myTrainingOutput[i]);
+    }
+    return 1.0 - sum / trainingSetCount();
+}
+
+// -----------------------------------------------------------------------------
+template <std::size_t InputCount, std::size_t HiddenCount, std::size_t OutputCount,
+          ActFunc ActFuncHidden, ActFunc ActFuncOutput>
+void StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, ActFuncHidden, ActFuncOutput>
+    ::printResults(std::ostream& ostream, const std::size_t decimalCount)
+{
+    ostream << std::fixed << std::setprecision(decimalCount);
+    ostream << "--------------------------------------------------------------------------------\n";
+    ostream << "Prediction accuracy: " << accuracy() * 100 << "%\n";
+
+    for (std::size_t i{}; i < trainingSetCount(); ++i)
+    {
+        const auto& input{myTrainingInput[i]};
+        const auto& reference{myTrainingOutput[i]};
+        ostream << "Input: ";
+        utils::vector::print<double>(input.data(), InputCount, ostream, ", ", decimalCount);
+        ostream << "prediction: ";
+        utils::vector::print<double>(predict(input).data(), OutputCount, ostream, ", ", 
+                                     decimalCount);
+        ostream << "reference: ";
+        utils::vector::print<double>(reference.data(), OutputCount, ostream, ", ", 
+                                     decimalCount);
+        ostream << "error: " << averageError(input, reference) << "\n";
+    }
+    ostream << "--------------------------------------------------------------------------------\n\n";
+}
+
+// -----------------------------------------------------------------------------
+template <std::size_t InputCount, std::size_t HiddenCount, std::size_t OutputCount,
+          ActFunc ActFuncHidden, ActFunc ActFuncOutput>
+template <ActFunc Func>
+double StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, ActFuncHidden, ActFuncOutput>
+    ::activation(const double number)
+{
+    if constexpr (Func == ActFunc::Relu) { return utils::math::relu(number); }
+    else { return utils::math::tanh(number); }
+}
+
+// -----------------------------------------------------------------------------
+template <std::size_t InputCount, std::size_t HiddenCount, std::size_t OutputCount,
+          ActFunc ActFuncHidden, ActFunc ActFuncOutput>
+template <ActFunc Func>
+double StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, ActFuncHidden, ActFuncOutput>
+    ::gradient(const double number)
+{
+    if constexpr (Func == ActFunc::Relu) { return utils::math::reluGradient(number); }
+    else { return 1.0 - number * number; }
+}
+
+// -----------------------------------------------------------------------------
+template <std::size_t InputCount, std::size_t HiddenCount, std::size_t OutputCount,
+          ActFunc ActFuncHidden, ActFunc ActFuncOutput>
+void StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, ActFuncHidden, ActFuncOutput>
+    ::feedforward(const Input& input)
+{
+    for (std::size_t i{}; i < HiddenCount; ++i)
+    {
+        auto sum{myHiddenBias[i]};
+        for (std::size_t j{}; j < InputCount; ++j) { sum += input[j] * myHiddenWeights[i][j]; }
+        myHiddenOutput[i] = activation<ActFuncHidden>(sum);
+    }
+
+    for (std::size_t i{}; i < OutputCount; ++i)
+    {
+        auto sum{myOutputBias[i]};
+        for (std::size_t j{}; j < HiddenCount; ++j) 
+        { 
+            sum += myHiddenOutput[j] * myOutputWeights[i][j]; 
+        }
+        myOutput[i] = activation<ActFuncOutput>(sum);
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <std::size_t InputCount, std::size_t HiddenCount, std::size_t OutputCount,
+          ActFunc ActFuncHidden, ActFunc ActFuncOutput>
+void StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, ActFuncHidden, ActFuncOutput>
+    ::backpropagate(const Output& reference)
+{
+    for (std::size_t i{}; i < OutputCount; ++i)
+    {
+        myOutputError[i] = (reference[i] - myOutput[i]) * gradient<ActFuncOutput>(myOutput[i]);
+    }
+
+    myHiddenError.fill(0.0);
+    for (std::size_t j{}; j < OutputCount; ++j)
+    {
+        for (std::size_t i{}; i < HiddenCount; ++i) 
+        { 
+            myHiddenError[i] += myOutputError[j] * myOutputWeights[j][i]; 
+        }
+    }
+    for (std::size_t i{}; i < HiddenCount; ++i) 
+    { 
+        myHiddenError[i] *= gradient<ActFuncHidden>(myHiddenOutput[i]); 
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <std::size_t InputCount, std::size_t HiddenCount, std::size_t OutputCount,
+          ActFunc ActFuncHidden, ActFunc ActFuncOutput>
+void StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, ActFuncHidden, ActFuncOutput>
+    ::optimize(const Input& input, const double learningRate)
+{
+    for (std::size_t i{}; i < HiddenCount; ++i)
+    {
+        const auto scale{myHiddenError[i] * learningRate};
+        myHiddenBias[i] += scale;
+        for (std::size_t j{}; j < InputCount; ++j) { myHiddenWeights[i][j] += scale * input[j]; }
+    }
+
+    for (std::size_t i{}; i < OutputCount; ++i)
+    {
+        const auto scale{myOutputError[i] * learningRate};
+        myOutputBias[i] += scale;
+        for (std::size_t j{}; j < HiddenCount; ++j) 
+        { 
+            myOutputWeights[i][j] += scale * myHiddenOutput[j]; 
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <std::size_t InputCount, std::size_t HiddenCount, std::size_t OutputCount,
+          ActFunc ActFuncHidden, ActFunc ActFuncOutput>
+double StaticNeuralNetwork<InputCount, HiddenCount, OutputCount, ActFuncHidden, ActFuncOutput>
+    ::averageError(const Input& input, const Output& reference)
+{
+    const auto& prediction{predict(input)};
+    double sum{};
+
+    for (std::size_t i{}; i < OutputCount; ++i)
+    {
+        sum += utils::math::absoluteValue(reference[i] - prediction[i]);
+    }
+    return sum / InputCount;
+}
+
+} // namespace ml
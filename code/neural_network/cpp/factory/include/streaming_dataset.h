@@ -0,0 +1,195 @@
+/*******************************************************************************
+ * @brief Implementation of training data streamed from file.
+ ******************************************************************************/
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "dataset_format.h"
+#include "matrix.h"
+
+namespace ml
+{
+
+/*******************************************************************************
+ * @brief Class implementation of training data streamed from file, which
+ *        enables training on datasets larger than memory.
+ *
+ *        The file is read in chunks on a background thread. Two chunk buffers
+ *        are used, so that the next chunk is read while the current one is
+ *        consumed. Training sets are shuffled within a bounded window: each
+ *        read set is drawn at random from the window, which is refilled from
+ *        the stream. Memory use is therefore bounded by the window size plus
+ *        two chunks, regardless of the size of the file.
+ *
+ *        Supported formats:
+ *
+ *        - CSV: One training set per line, holding the input values followed
+ *          by the reference values separated by commas. Empty lines are
+ *          skipped, and a first line not starting with a number is treated
+ *          as a header.
+ *
+ *        - Binary: Consecutive records of the input values followed by the
+ *          reference values, stored as T in native byte order.
+ *
+ *        This class is non-copyable and non-movable. Explicit instantiations
+ *        are provided for float and double.
+ *
+ * @tparam T The floating-point type of the training data (default = double).
+ ******************************************************************************/
+template <typename T = double>
+class StreamingDataset
+{
+public:
+
+    /*******************************************************************************
+     * @brief Creates new streaming dataset. Reading of the first chunk starts
+     *        immediately on the background thread.
+     *
+     * @param path          The path of the file to stream.
+     * @param inputCount    The number of input values per training set.
+     * @param outputCount   The number of reference values per training set.
+     * @param format        The format of the file (default = CSV).
+     * @param chunkSize     The number of training sets per chunk (default = 1024).
+     * @param shuffleWindow The number of training sets to shuffle between
+     *                      (default = 4096). Use 1 to read the training sets
+     *                      in file order.
+     ******************************************************************************/
+    StreamingDataset(const std::string& path, const std::size_t inputCount,
+                     const std::size_t outputCount,
+                     const DatasetFormat format = DatasetFormat::Csv,
+                     const std::size_t chunkSize = 1024U,
+                     const std::size_t shuffleWindow = 4096U);
+
+    /*******************************************************************************
+     * @brief Deletes streaming dataset. The background thread is stopped.
+     ******************************************************************************/
+    ~StreamingDataset();
+
+    /*******************************************************************************
+     * @brief Provides the number of input values per training set.
+     *
+     * @return The number of input values as an unsigned integer.
+     ******************************************************************************/
+    std::size_t inputCount() const noexcept;
+
+    /*******************************************************************************
+     * @brief Provides the number of reference values per training set.
+     *
+     * @return The number of reference values as an unsigned integer.
+     ******************************************************************************/
+    std::size_t outputCount() const noexcept;
+
+    /*******************************************************************************
+     * @brief Reads the next training sets of the current pass over the file.
+     *
+     * @param input     Reference to matrix in which to store one input per row.
+     *                  The matrix is resized to the number of read sets.
+     * @param reference Reference to matrix in which to store one reference per
+     *                  row. The matrix is resized to the number of read sets.
+     * @param count     The maximum number of training sets to read.
+     *
+     * @return The number of read training sets, which is 0 once the entire
+     *         file has been read.
+     ******************************************************************************/
+    std::size_t read(Matrix<T>& input, Matrix<T>& reference, const std::size_t count);
+
+    /*******************************************************************************
+     * @brief Starts a new pass from the beginning of the file. Nothing is done
+     *        if no training set has been read since the current pass started.
+     ******************************************************************************/
+    void rewind();
+
+    StreamingDataset()                                   = delete; // No default constructor.
+    StreamingDataset(const StreamingDataset&)            = delete; // No copy constructor.
+    StreamingDataset(StreamingDataset&&)                 = delete; // No move constructor.
+    StreamingDataset& operator=(const StreamingDataset&) = delete; // No copy assignment.
+    StreamingDataset& operator=(StreamingDataset&&)      = delete; // No move assignment.
+
+private:
+
+    /*******************************************************************************
+     * @brief Structure holding a chunk of training sets read from file.
+     ******************************************************************************/
+    struct Chunk
+    {
+        Matrix<T> input;     // Input of each training set in the chunk.
+        Matrix<T> reference; // Reference of each training set in the chunk.
+        std::size_t count;   // The number of training sets (0 = end of file).
+        bool filled;         // Indicates if the chunk is ready to be consumed.
+    };
+
+    /*******************************************************************************
+     * @brief Starts a new pass over the file on the background thread.
+     ******************************************************************************/
+    void startReader();
+
+    /*******************************************************************************
+     * @brief Stops the background thread, if running.
+     ******************************************************************************/
+    void stopReader();
+
+    /*******************************************************************************
+     * @brief Reads the file chunk by chunk until the end of the file is reached
+     *        or the reader is stopped. Runs on the background thread.
+     ******************************************************************************/
+    void readFile();
+
+    /*******************************************************************************
+     * @brief Fills specified chunk with training sets read from a CSV file.
+     *
+     * @param file       Reference to the file to read from.
+     * @param chunk      Reference to the chunk to fill.
+     * @param lineNumber Reference to the number of lines read so far.
+     *
+     * @return The number of read training sets.
+     ******************************************************************************/
+    std::size_t readCsv(std::istream& file, Chunk& chunk, std::size_t& lineNumber);
+
+    /*******************************************************************************
+     * @brief Fills specified chunk with training sets read from a binary file.
+     *
+     * @param file  Reference to the file to read from.
+     * @param chunk Reference to the chunk to fill.
+     *
+     * @return The number of read training sets.
+     ******************************************************************************/
+    std::size_t readBinary(std::istream& file, Chunk& chunk);
+
+    /*******************************************************************************
+     * @brief Moves the next streamed training set into the shuffle window.
+     *
+     * @return True if a training set was moved, false at the end of the pass.
+     ******************************************************************************/
+    bool fillWindow();
+
+    const std::string myPath;            // Path of the streamed file.
+    const std::size_t myInputCount;      // Number of input values per training set.
+    const std::size_t myOutputCount;     // Number of reference values per training set.
+    const DatasetFormat myFormat;        // Format of the streamed file.
+    const std::size_t myChunkSize;       // Number of training sets per chunk.
+
+    std::array<Chunk, 2U> myChunks;      // Chunks filled and consumed alternately.
+    std::thread myReader;                // Background thread reading the file.
+    std::mutex myMutex;                  // Protects the chunk states.
+    std::condition_variable myCondition; // Signals filled and consumed chunks.
+    bool myStopping;                     // Indicates if the reader shall stop.
+    std::exception_ptr myError;          // Error raised by the reader (if any).
+
+    std::size_t myChunkIndex;            // Index of the chunk being consumed.
+    std::size_t myChunkRow;              // Next row to consume in the chunk.
+    bool myHoldingChunk;                 // Indicates if a chunk is being consumed.
+    bool myEndOfPass;                    // Indicates if the pass has been read.
+    bool myPassStarted;                  // Indicates if any set has been read.
+
+    Matrix<T> myWindowInput;             // Input of each set in the shuffle window.
+    Matrix<T> myWindowReference;         // Reference of each set in the shuffle window.
+    std::size_t myWindowCount;           // Number of sets in the shuffle window.
+};
+
+} // namespace ml
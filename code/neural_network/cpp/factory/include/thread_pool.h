@@ -0,0 +1,258 @@
+/*******************************************************************************
+ * @brief Implementation of a work-stealing thread pool.
+ ******************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils
+{
+
+/*******************************************************************************
+ * @brief Class implementation of a work-stealing thread pool, which runs
+ *        parallel work on threads created once instead of per call.
+ *
+ *        Each thread owns a task queue. Tasks submitted from a pool thread are
+ *        pushed to its own queue and popped in last-in, first-out order, which
+ *        keeps nested work in cache. Idle threads steal the oldest tasks from
+ *        the queues of other threads. Tasks submitted from other threads are
+ *        pushed to a shared queue.
+ *
+ *        A thread waiting for a task group runs pending tasks while it waits,
+ *        so task groups can be nested without deadlock. The waiting thread is
+ *        counted as one of the threads of the pool, which means that a pool of
+ *        one thread runs all tasks inline.
+ *
+ *        Tasks are queued as small descriptors referencing the caller's task
+ *        in queues of fixed capacity allocated with the pool, so submitting 
+ *        and running tasks never allocates memory. A task submitted to a full
+ *        queue is run inline by the submitting thread.
+ *
+ *        This class is non-copyable and non-movable.
+ ******************************************************************************/
+class ThreadPool
+{
+public:
+
+    /*******************************************************************************
+     * @brief Class implementation of a group of tasks, which can be waited for
+     *        as a whole. An exception thrown by a task is rethrown by wait.
+     ******************************************************************************/
+    class TaskGroup
+    {
+    public:
+
+        /*******************************************************************************
+         * @brief Creates new task group.
+         *
+         * @param pool Reference to the thread pool running the tasks.
+         ******************************************************************************/
+        explicit TaskGroup(ThreadPool& pool) noexcept;
+
+        /*******************************************************************************
+         * @brief Deletes task group after waiting for its remaining tasks.
+         *        Exceptions of tasks not waited for are discarded.
+         ******************************************************************************/
+        ~TaskGroup();
+
+        /*******************************************************************************
+         * @brief Submits a task to the thread pool, which runs it for a range of
+         *        indexes. The task is referenced rather than copied, so it must
+         *        stay alive until the group has been waited for.
+         *
+         * @tparam Task The task type, callable with the first and last index of
+         *              the range, where the last index is excluded.
+         *
+         * @param task  Reference to the task to run.
+         * @param first The first index of the range.
+         * @param last  The index after the last index of the range.
+         ******************************************************************************/
+        template <typename Task>
+        void run(const Task& task, const std::size_t first, const std::size_t last);
+
+        /*******************************************************************************
+         * @brief Waits until all submitted tasks have finished. Pending tasks
+         *        are run by the calling thread while waiting. Once none is left,
+         *        the calling thread sleeps until the last task of the group has
+         *        finished. If any task threw, the first exception is rethrown 
+         *        once all tasks have finished.
+         ******************************************************************************/
+        void wait();
+
+        TaskGroup()                            = delete; // No default constructor.
+        TaskGroup(const TaskGroup&)            = delete; // No copy constructor.
+        TaskGroup(TaskGroup&&)                 = delete; // No move constructor.
+        TaskGroup& operator=(const TaskGroup&) = delete; // No copy assignment.
+        TaskGroup& operator=(TaskGroup&&)      = delete; // No move assignment.
+
+    private:
+
+        friend class ThreadPool; // Marks the tasks of the group as finished.
+
+        /*******************************************************************************
+         * @brief Marks a task of the group as finished.
+         *
+         * @param error The exception thrown by the task (if any).
+         ******************************************************************************/
+        void finish(std::exception_ptr error);
+
+        ThreadPool& myPool;                  // The thread pool running the tasks.
+        std::mutex myMutex;                  // Protects the state of the group.
+        std::condition_variable myCondition; // Signals the last finished task.
+        std::size_t myPendingCount;          // The number of unfinished tasks.
+        std::exception_ptr myError;          // First exception thrown by a task.
+    };
+
+    /*******************************************************************************
+     * @brief Creates new thread pool.
+     *
+     * @param threadCount The number of threads running tasks, including the
+     *                    thread waiting for them. One thread less is created.
+     ******************************************************************************/
+    explicit ThreadPool(const std::size_t threadCount);
+
+    /*******************************************************************************
+     * @brief Deletes thread pool. The threads are stopped and joined.
+     ******************************************************************************/
+    ~ThreadPool();
+
+    /*******************************************************************************
+     * @brief Provides the shared thread pool, which is created on first use.
+     *        The number of threads is read from the environment variable
+     *        ML_THREAD_COUNT if set, else the hardware concurrency is used.
+     *
+     * @return Reference to the shared thread pool.
+     ******************************************************************************/
+    static ThreadPool& instance();
+
+    /*******************************************************************************
+     * @brief Provides the number of threads running tasks, including the thread
+     *        waiting for them.
+     *
+     * @return The number of threads as an unsigned integer.
+     ******************************************************************************/
+    std::size_t threadCount() const noexcept;
+
+    /*******************************************************************************
+     * @brief Runs specified task over a range of indexes in parallel. The range
+     *        is split into chunks of at most the given grain size, one task per
+     *        chunk. The range is run inline if it fits in one chunk.
+     *
+     * @tparam Task The task type, callable with the first and last index of
+     *              a chunk, where the last index is excluded.
+     *
+     * @param first     The first index of the range.
+     * @param last      The index after the last index of the range.
+     * @param grainSize The maximum number of indexes per chunk.
+     * @param task      Reference to the task to run for each chunk.
+     ******************************************************************************/
+    template <typename Task>
+    void parallelFor(const std::size_t first, const std::size_t last,
+                     const std::size_t grainSize, const Task& task);
+
+    ThreadPool()                             = delete; // No default constructor.
+    ThreadPool(const ThreadPool&)            = delete; // No copy constructor.
+    ThreadPool(ThreadPool&&)                 = delete; // No move constructor.
+    ThreadPool& operator=(const ThreadPool&) = delete; // No copy assignment.
+    ThreadPool& operator=(ThreadPool&&)      = delete; // No move assignment.
+
+private:
+
+    /*******************************************************************************
+     * @brief The maximum number of tasks waiting in the queue of one thread.
+     ******************************************************************************/
+    static constexpr std::size_t QueueCapacity{1024U};
+
+    /*******************************************************************************
+     * @brief Structure holding a task submitted by a task group, i.e. a range
+     *        of indexes along with the type-erased task to run for it.
+     ******************************************************************************/
+    struct Chunk
+    {
+        void (*invoke)(const void*, std::size_t, std::size_t); // Runs the task for a range.
+        const void* task;                                      // The task to run.
+        std::size_t first;                                     // First index of the range.
+        std::size_t last;                                      // Index after the range.
+        TaskGroup* group;                                      // The group of the task.
+    };
+
+    /*******************************************************************************
+     * @brief Structure holding the task queue of one thread as a ring buffer.
+     ******************************************************************************/
+    struct Queue
+    {
+        std::mutex mutex;          // Protects the tasks.
+        std::vector<Chunk> chunks; // Ring buffer of tasks waiting to be run.
+        std::size_t front;         // Index of the oldest task in the ring buffer.
+        std::size_t count;         // The number of tasks waiting to be run.
+    };
+
+    /*******************************************************************************
+     * @brief Calls a task of specified type for a range of indexes.
+     *
+     * @tparam Task The type of the task.
+     *
+     * @param task  Pointer to the task to call.
+     * @param first The first index of the range.
+     * @param last  The index after the last index of the range.
+     ******************************************************************************/
+    template <typename Task>
+    static void invoke(const void* task, const std::size_t first, const std::size_t last);
+
+    /*******************************************************************************
+     * @brief Pushes a task to the queue of the calling thread.
+     *
+     * @param chunk Reference to the task to push.
+     *
+     * @return True if the task was pushed, false if the queue is full.
+     ******************************************************************************/
+    bool push(const Chunk& chunk);
+
+    /*******************************************************************************
+     * @brief Runs a task and marks it as finished in its task group.
+     *
+     * @param chunk Reference to the task to run.
+     ******************************************************************************/
+    static void runChunk(const Chunk& chunk);
+
+    /*******************************************************************************
+     * @brief Runs one pending task, popped from the queue of the calling thread
+     *        or else stolen from the queue of another thread.
+     *
+     * @return True if a task was run, false if no task was pending.
+     ******************************************************************************/
+    bool runPendingTask();
+
+    /*******************************************************************************
+     * @brief Runs tasks until the thread pool is stopped. Runs on each thread
+     *        of the pool.
+     *
+     * @param queue The index of the queue owned by the thread.
+     ******************************************************************************/
+    void work(const std::size_t queue);
+
+    /*******************************************************************************
+     * @brief Provides the index of the queue of the calling thread.
+     *
+     * @return The index of the queue as an unsigned integer.
+     ******************************************************************************/
+    std::size_t queueIndex() const noexcept;
+
+    std::vector<std::unique_ptr<Queue>> myQueues; // Task queue per thread (0 = shared).
+    std::vector<std::thread> myThreads;           // Threads of the pool.
+    std::mutex myMutex;                           // Protects sleeping and stopping.
+    std::condition_variable myCondition;          // Signals pushed tasks and stopping.
+    std::atomic<std::size_t> myQueuedCount;       // The number of queued tasks.
+    bool myStopping;                              // Indicates if the pool shall stop.
+};
+
+} // namespace utils
+
+#include "thread_pool_impl.h"
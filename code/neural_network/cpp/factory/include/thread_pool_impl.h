@@ -0,0 +1,59 @@
+/*******************************************************************************
+ * @brief Implementation details of the utils::ThreadPool class.
+ *
+ * @note Do not include this file in any application!
+ ******************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace utils
+{
+
+// -----------------------------------------------------------------------------
+template <typename Task>
+void ThreadPool::TaskGroup::run(const Task& task, const std::size_t first, 
+                                const std::size_t last)
+{
+    const Chunk chunk{&ThreadPool::invoke<Task>, &task, first, last, this};
+    {
+        std::lock_guard<std::mutex> lock{myMutex};
+        ++myPendingCount;
+    }
+    if (!myPool.push(chunk)) { runChunk(chunk); }
+}
+
+// -----------------------------------------------------------------------------
+template <typename Task>
+void ThreadPool::parallelFor(const std::size_t first, const std::size_t last,
+                             const std::size_t grainSize, const Task& task)
+{
+    if (grainSize == 0U)
+    {
+        throw std::invalid_argument("Invalid grain size 0!");
+    }
+    if (last <= first) { return; }
+    if (myThreads.empty() || (last - first <= grainSize))
+    {
+        task(first, last);
+        return;
+    }
+    TaskGroup group{*this};
+
+    for (auto begin{first}; begin < last; begin += std::min(grainSize, last - begin))
+    {
+        const auto end{begin + std::min(grainSize, last - begin)};
+        group.run(task, begin, end);
+    }
+    group.wait();
+}
+
+// -----------------------------------------------------------------------------
+template <typename Task>
+void ThreadPool::invoke(const void* task, const std::size_t first, const std::size_t last)
+{
+    (*static_cast<const Task*>(task))(first, last);
+}
+
+} // namespace utils
@@ -0,0 +1,20 @@
+/*******************************************************************************
+ * @brief Implementation of strategies for parallel training of neural networks.
+ ******************************************************************************/
+#pragma once
+
+namespace ml
+{
+
+/*******************************************************************************
+ * @brief Enum representing the different strategies available for training
+ *        neural networks with multiple threads.
+ ******************************************************************************/
+enum class TrainStrategy : unsigned
+{
+    Synchronous,  // Gradients of each batch are reduced and applied once per batch.
+    Asynchronous, // Lock-free updates of shared parameters per thread (Hogwild).
+    Count,        // The number of training strategies available.
+};
+
+} // namespace ml
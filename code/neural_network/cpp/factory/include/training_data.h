@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * @brief Implementation of training data stored in contiguous blocks.
+ ******************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "matrix.h"
+#include "scalar_type.h"
+
+namespace ml
+{
+
+/*******************************************************************************
+ * @brief Class implementation of training data, holding the input and the
+ *        reference of each training set as two row-major matrices.
+ *
+ *        Training data is either copied from vectors or loaded from a binary
+ *        training data file. A loaded file is memory mapped and the matrices
+ *        view the mapped pages without copying, so that loading takes the same
+ *        time regardless of the size of the file.
+ *
+ *        Layout of the binary format (all fields in native byte order):
+ *
+ *        - A Header at offset 0.
+ *        - The input block at Header::inputOffset, holding one input per row.
+ *        - The reference block at Header::referenceOffset, holding one
+ *          reference per row.
+ *
+ *        Both blocks are aligned to and use the padded row layout of
+ *        ml::Matrix, with values stored as T.
+ *
+ *        Explicit instantiations are provided for float and double.
+ *
+ * @tparam T The floating-point type of the training data (default = double).
+ ******************************************************************************/
+template <typename T = double>
+class TrainingData
+{
+public:
+
+    /*******************************************************************************
+     * @brief Structure holding the header of a training data file.
+     ******************************************************************************/
+    struct Header
+    {
+        char magic[8U];                // File signature, see Magic.
+        std::uint32_t version;         // Format version, see Version.
+        ScalarType scalarType;         // Scalar type of the values.
+        std::uint64_t setCount;        // Number of training sets.
+        std::uint64_t inputCount;      // Number of input values per training set.
+        std::uint64_t outputCount;     // Number of reference values per training set.
+        std::uint64_t inputOffset;     // File offset of the input block in bytes.
+        std::uint64_t referenceOffset; // File offset of the reference block in bytes.
+        std::uint64_t fileSize;        // Total size of the file in bytes.
+    };
+
+    static constexpr char Magic[8U]{'M', 'L', 'D', 'A', 'T', 'A', '\0', '\0'}; // Signature.
+    static constexpr std::uint32_t Version{1U};                                // Version.
+    static_assert(sizeof(Header) == 64U, "Unexpected training data header size!");
+
+    /*******************************************************************************
+     * @brief Creates empty training data.
+     ******************************************************************************/
+    TrainingData() noexcept;
+
+    /*******************************************************************************
+     * @brief Creates training data holding a copy of the given training sets.
+     *
+     * @param input  Reference to vector holding the input of each training set.
+     * @param output Reference to vector holding the reference of each training set.
+     ******************************************************************************/
+    TrainingData(const std::vector<std::vector<T>>& input,
+                 const std::vector<std::vector<T>>& output);
+
+    /*******************************************************************************
+     * @brief Loads training data from a binary training data file. The file is
+     *        memory mapped and kept mapped for as long as the training data 
+     *        exists. Copies of loaded training data hold their own values.
+     *
+     * @param path The path of the training data file.
+     ******************************************************************************/
+    explicit TrainingData(const std::string& path);
+
+    /*******************************************************************************
+     * @brief Converts a CSV file into a binary training data file. The CSV file
+     *        is parsed once while being streamed, see ml::StreamingDataset.
+     *
+     * @param csvPath     The path of the CSV file to convert.
+     * @param path        The path of the training data file to create. Any
+     *                    existing file is replaced.
+     * @param inputCount  The number of input values per training set.
+     * @param outputCount The number of reference values per training set.
+     *
+     * @return The number of converted training sets.
+     ******************************************************************************/
+    static std::size_t convertCsv(const std::string& csvPath, const std::string& path,
+                                  const std::size_t inputCount,
+                                  const std::size_t outputCount);
+
+    /*******************************************************************************
+     * @brief Provides the number of training sets.
+     *
+     * @return The number of training sets as an unsigned integer.
+     ******************************************************************************/
+    std::size_t size() const noexcept;
+
+    /*******************************************************************************
+     * @brief Indicates if the training data is empty.
+     *
+     * @return True if the training data holds no training sets, else false.
+     ******************************************************************************/
+    bool empty() const noexcept;
+
+    /*******************************************************************************
+     * @brief Provides the number of input values per training set.
+     *
+     * @return The number of input values as an unsigned integer.
+     ******************************************************************************/
+    std::size_t inputCount() const noexcept;
+
+    /*******************************************************************************
+     * @brief Provides the number of reference values per training set.
+     *
+     * @return The number of reference values as an unsigned integer.
+     ******************************************************************************/
+    std::size_t outputCount() const noexcept;
+
+    /*******************************************************************************
+     * @brief Provides the input of the training sets.
+     *
+     * @return Reference to matrix holding the input of each training set.
+     ******************************************************************************/
+    const Matrix<T>& input() const noexcept;
+
+    /*******************************************************************************
+     * @brief Provides the reference of the training sets.
+     *
+     * @return Reference to matrix holding the reference of each training set.
+     ******************************************************************************/
+    const Matrix<T>& reference() const noexcept;
+
+private:
+
+    std::shared_ptr<const void> myStorage; // Memory viewed by the matrices (if any).
+    Matrix<T> myInput;                     // Input of each training set.
+    Matrix<T> myReference;                 // Reference of each training set.
+};
+
+} // namespace ml
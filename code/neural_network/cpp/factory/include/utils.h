@@ -17,8 +17,19 @@ namespace
 namespace random
 {
 
+/*******************************************************************************
+ * @brief Seeds the random number generation of all threads, which makes 
+ *        random initialization and shuffling reproducible. Without a seed, a 
+ *        random seed is used. See utils::RandomGenerator.
+ * 
+ * @param seed The seed to use.
+ ******************************************************************************/
+inline void seed(const std::uint64_t seed);
+
 /*******************************************************************************
  * @brief Generates a random number in the range of specified min and max values.
+ *        The number is drawn from the generator of the calling thread without 
+ *        bias. Floating-point numbers are drawn from the range [min, max).
  * 
  * @tparam T The type of the random number to generate.
  * 
@@ -66,7 +77,8 @@ void initRandom(std::vector<std::vector<T>>& vector,
                 const T min = 0, const T max = 100);
 
 /*******************************************************************************
- * @brief Shuffle the content of one-dimensional vector.
+ * @brief Shuffle the content of one-dimensional vector with the Fisher-Yates
+ *        algorithm, so that every permutation is equally likely.
  * 
  * @tparam T The vector type.
  * 
@@ -76,7 +88,8 @@ template <typename T>
 void shuffle(std::vector<T>& vector);
 
 /*******************************************************************************
- * @brief Shuffle the content of two-dimensional vector.
+ * @brief Shuffle the content of two-dimensional vector with the Fisher-Yates
+ *        algorithm, so that every permutation is equally likely.
  * 
  * @tparam T The vector type.
  * 
@@ -102,6 +115,24 @@ template <typename T>
 void print(const std::vector<T>& vector, std::ostream& ostream = std::cout, 
            const char* end = "\n", const std::size_t decimalCount = 1U);
 
+/*******************************************************************************
+ * @brief Prints content of contiguous sequence, such as a matrix row.
+ * 
+ * @tparam T The element type.
+ * 
+ * @note This function only works for arithmetic types and strings.
+ * 
+ * @param data         Pointer to the first element of the sequence.
+ * @param size         The number of elements in the sequence.
+ * @param ostream      Reference to output stream (default = terminal print).
+ * @param end          Ending characters (default = new line).
+ * @param decimalCount Number of decimals to print when using floating
+ *                     point numbers (default = 1).
+ ******************************************************************************/
+template <typename T>
+void print(const T* data, const std::size_t size, std::ostream& ostream = std::cout, 
+           const char* end = "\n", const std::size_t decimalCount = 1U);
+
 /*******************************************************************************
  * @brief Prints content of two-dimensional vector.
  * 
@@ -206,41 +237,53 @@ constexpr T round(const double number);
  * @brief Provides the Rectified Linear Unit (ReLU) activation for a 
  *        given input.
  * 
+ * @tparam T The floating-point type of the number.
+ * 
  * @param number The number for which to calculate the Relu.
  * 
- * @return The ReLU activation as a double.
+ * @return The ReLU activation.
  ******************************************************************************/
-constexpr double relu(const double number);
+template <typename T>
+constexpr T relu(const T number);
 
 /*******************************************************************************
  * @brief Provides the gradient of the Rectified Linear Unit (ReLU) function 
  *        for a given input.
  * 
+ * @tparam T The floating-point type of the number.
+ * 
  * @param number The number for which to calculate the ReLU gradient.
  * 
- * @return The ReLU gradient as a double.
+ * @return The ReLU gradient.
  ******************************************************************************/
-constexpr double reluGradient(const double number);
+template <typename T>
+constexpr T reluGradient(const T number);
 
 /*******************************************************************************
  * @brief Provides the hyperbolic tangent (tanh) for a given input.
  * 
+ * @tparam T The floating-point type of the number.
+ * 
  * @param number The number for which to calculate the hyperbolic tangent.
  * 
- * @return The hyperbolic tangent as a double.
+ * @return The hyperbolic tangent.
  ******************************************************************************/
-constexpr double tanh(const double number);
+template <typename T>
+constexpr T tanh(const T number);
 
 /*******************************************************************************
- * @brief Provides the gradient of the hyperbolic tangent (tanh) for a 
- *        given input.
+ * @brief Provides the gradient of the hyperbolic tangent (tanh) from its
+ *        output y as 1 - y^2, so that tanh is not evaluated again.
+ * 
+ * @tparam T The floating-point type of the number.
  * 
- * @param number The number for which to calculate the gradient of the 
- *               hyperbolic tangent.
+ * @param output The output of the hyperbolic tangent for which to calculate
+ *               the gradient.
  * 
- * @return The gradient of the hyperbolic tangent as a double.
+ * @return The gradient of the hyperbolic tangent.
  ******************************************************************************/
-constexpr double tanhGradient(const double number);
+template <typename T>
+constexpr T tanhGradient(const T output);
 
 } // namespace math
 
@@ -7,12 +7,13 @@
 
 #include <cmath>
 #include <cstdint>
-#include <cstdlib>
-#include <ctime>
 #include <iomanip>
+#include <utility>
 #include <vector>
 #include <type_traits>
 
+#include "random_generator.h"
+
 namespace utils 
 {
 namespace 
@@ -21,21 +22,12 @@ namespace random
 {
 
 // -----------------------------------------------------------------------------
-inline void init() 
-{
-    static auto generatorInitialized{false};
-    if (!generatorInitialized) 
-    {
-        std::srand(std::time(nullptr));
-        generatorInitialized = true;
-    }
-}
+inline void seed(const std::uint64_t seed) { RandomGenerator::seed(seed); }
 
 // -----------------------------------------------------------------------------
 template <typename T>
 T getNumber(const T min, const T max) 
 {
-    init();
     static_assert(std::is_arithmetic<T>::value, 
         "Non-arithmetic type selected for new random number!");
 
@@ -44,15 +36,7 @@ T getNumber(const T min, const T max)
         throw std::invalid_argument(
             "Cannot generate random number when min is more than max!"); 
     }
-
-    if constexpr (std::is_integral<T>::value) 
-    {
-        return static_cast<T>((std::rand() % (max + 1 - min)) + min);
-    } 
-    else 
-    {
-        return (std::rand() / static_cast<T>(RAND_MAX)) * (max - min) + min;
-    }
+    return RandomGenerator::local().uniform<T>(min, max);
 }
 
 } // namespace random
@@ -102,12 +86,11 @@ void initRandom(std::vector<std::vector<T>>& vector,
 template <typename T>
 void shuffle(std::vector<T>& vector) 
 {
-    for (std::size_t i{}; i < vector.size(); ++i) 
+    auto& generator{RandomGenerator::local()};
+
+    for (auto i{vector.size()}; i > 1U; --i) 
     {
-        const auto r{static_cast<std::size_t>(std::rand() % vector.size())};
-        const auto temp{vector[i]};
-        vector[i] = vector[r];
-        vector[r] = temp;
+        std::swap(vector[i - 1U], vector[generator.bounded(i)]);
     }
 }
 
@@ -115,18 +98,17 @@ void shuffle(std::vector<T>& vector)
 template <typename T>
 void shuffle(std::vector<std::vector<T>>& vector) 
 {
-    for (std::size_t i{}; i < vector.size(); ++i) 
+    auto& generator{RandomGenerator::local()};
+
+    for (auto i{vector.size()}; i > 1U; --i) 
     {
-        const auto r{static_cast<std::size_t>(std::rand() % vector.size())};
-        const auto temp{vector[i]};
-        vector[i] = vector[r];
-        vector[r] = temp;
+        std::swap(vector[i - 1U], vector[generator.bounded(i)]);
     }
 }
 
 // -----------------------------------------------------------------------------
 template <typename T>
-void print(const std::vector<T>& vector, std::ostream& ostream, 
+void print(const T* data, const std::size_t size, std::ostream& ostream, 
            const char* end, const std::size_t decimalCount)
 {
     static_assert(std::is_arithmetic<T>::value || utils::type_traits::is_string<T>::value,
@@ -147,10 +129,10 @@ void print(const std::vector<T>& vector, std::ostream& ostream,
         else { return value; }
     };
 
-    for (std::size_t i{}; i < vector.size(); ++i)
+    for (std::size_t i{}; i < size; ++i)
     {
-        const auto value{roundNearZeroValue(vector[i])};
-        if (i < vector.size() - 1U) { ostream << value << ", "; }
+        const auto value{roundNearZeroValue(data[i])};
+        if (i < size - 1U) { ostream << value << ", "; }
         else { ostream << value; }
     }
 
@@ -158,6 +140,14 @@ void print(const std::vector<T>& vector, std::ostream& ostream,
     if (end != nullptr) { ostream << end; }
 }
 
+// -----------------------------------------------------------------------------
+template <typename T>
+void print(const std::vector<T>& vector, std::ostream& ostream, 
+           const char* end, const std::size_t decimalCount)
+{
+    print<T>(vector.data(), vector.size(), ostream, end, decimalCount);
+}
+
 // -----------------------------------------------------------------------------
 template <typename T>
 void print(const std::vector<std::vector<T>>& vector, std::ostream& ostream, 
@@ -258,16 +248,20 @@ constexpr T round(const double number)
 }
 
 // -----------------------------------------------------------------------------
-constexpr double relu(const double number) { return number > 0 ? number : 0; }
+template <typename T>
+constexpr T relu(const T number) { return number > 0 ? number : 0; }
 
 // -----------------------------------------------------------------------------
-constexpr double reluGradient(const double number) { return number > 0 ? 1 : 0; }
+template <typename T>
+constexpr T reluGradient(const T number) { return number > 0 ? 1 : 0; }
 
 // -----------------------------------------------------------------------------
-constexpr double tanh(const double number) { return std::tanh(number); }
+template <typename T>
+constexpr T tanh(const T number) { return std::tanh(number); }
 
 // -----------------------------------------------------------------------------
-constexpr double tanhGradient(const double number) { return 1 - std::pow(std::tanh(number), 2); }
+template <typename T>
+constexpr T tanhGradient(const T output) { return 1 - output * output; }
 
 } // namespace math
 } // namespace
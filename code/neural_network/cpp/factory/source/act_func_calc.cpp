@@ -1,43 +1,62 @@
 /*******************************************************************************
  * @brief Implementation details of class ml::ActFuncCalc.
  ******************************************************************************/
+#include <algorithm>
 #include <stdexcept>
 
 #include "act_func_calc.h"
+#include "kernels.h"
 #include "utils.h"
 
 namespace ml
 {
 
 // -----------------------------------------------------------------------------
-ActFuncCalc::ActFuncCalc(const ActFunc actFunc)
+template <typename T>
+ActFuncCalc<T>::ActFuncCalc(const ActFunc actFunc, const TanhPrecision tanhPrecision)
     : myActFunc{actFunc}
+    , myTanhPrecision{tanhPrecision}
 {
     if (actFunc >= ActFunc::Count)
     {
         throw std::invalid_argument("Invalid activation function!\n");
     }
+    if (tanhPrecision >= TanhPrecision::Count)
+    {
+        throw std::invalid_argument("Invalid tanh precision!\n");
+    }
 }
 
 // -----------------------------------------------------------------------------
-ActFunc ActFuncCalc::actFunc() const { return myActFunc; }
+template <typename T>
+ActFunc ActFuncCalc<T>::actFunc() const { return myActFunc; }
 
 // -----------------------------------------------------------------------------
-double ActFuncCalc::output(const double number) const
+template <typename T>
+TanhPrecision ActFuncCalc<T>::tanhPrecision() const { return myTanhPrecision; }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+T ActFuncCalc<T>::output(const T number) const
 {
     switch (myActFunc)
     {
         case ActFunc::Relu:
             return utils::math::relu(number);
         case ActFunc::Tanh:
-            return utils::math::tanh(number);
+        {
+            T output{};
+            kernels::tanh(&number, &output, 1U, myTanhPrecision);
+            return output;
+        }
         default:
             throw std::invalid_argument("Invalid activation function!\n");       
     }
 }
 
 // -----------------------------------------------------------------------------
-double ActFuncCalc::gradient(const double number) const
+template <typename T>
+T ActFuncCalc<T>::gradient(const T number) const
 {
     switch (myActFunc)
     {
@@ -51,7 +70,62 @@ double ActFuncCalc::gradient(const double number) const
 }
 
 // -----------------------------------------------------------------------------
-const char* ActFuncCalc::actFuncName() const
+template <typename T>
+void ActFuncCalc<T>::output(const T* input, T* output, const std::size_t size) const
+{
+    switch (myActFunc)
+    {
+        case ActFunc::Relu:
+            kernels::relu(input, output, size);
+            break;
+        case ActFunc::Tanh:
+            kernels::tanh(input, output, size, myTanhPrecision);
+            break;
+        default:
+            throw std::invalid_argument("Invalid activation function!\n");       
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void ActFuncCalc<T>::multiplyGradient(const T* number, T* error, const std::size_t size) const
+{
+    switch (myActFunc)
+    {
+        case ActFunc::Relu:
+            kernels::reluGradient(number, error, size);
+            break;
+        case ActFunc::Tanh:
+            kernels::tanhGradient(number, error, size);
+            break;
+        default:
+            throw std::invalid_argument("Invalid activation function!\n");       
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void ActFuncCalc<T>::gradient(const T* number, T* gradient, const std::size_t size) const
+{
+    // The gradients are obtained by multiplying ones, so the multiplying kernels are reused.
+    std::fill(gradient, gradient + size, T{1});
+
+    switch (myActFunc)
+    {
+        case ActFunc::Relu:
+            kernels::reluGradient(number, gradient, size);
+            break;
+        case ActFunc::Tanh:
+            kernels::tanhGradient(number, gradient, size);
+            break;
+        default:
+            throw std::invalid_argument("Invalid activation function!\n");       
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+const char* ActFuncCalc<T>::actFuncName() const
 {
     switch (myActFunc)
     {
@@ -64,4 +138,7 @@ const char* ActFuncCalc::actFuncName() const
     }
 }
 
+template class ActFuncCalc<float>;
+template class ActFuncCalc<double>;
+
 } // namespace ml
\ No newline at end of file
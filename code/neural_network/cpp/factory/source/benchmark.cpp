@@ -0,0 +1,360 @@
+/*******************************************************************************
+ * @brief Benchmark suite for the dense layer kernels, the training throughput
+ *        and the inference latency of the neural network, which prints its
+ *        results in a machine-readable format.
+ ******************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "factory.h"
+#include "kernels.h"
+#include "static_neural_network.h"
+#include "thread_pool.h"
+#include "utils.h"
+
+#ifndef BENCHMARK_FLAGS
+#define BENCHMARK_FLAGS "unknown"
+#endif
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+/*******************************************************************************
+ * @brief Structure holding the result of one benchmark case.
+ ******************************************************************************/
+struct Result
+{
+    std::string name;          // The name of the benchmarked operation.
+    std::string type;          // The floating-point type of the parameters.
+    std::size_t size;          // The layer width or batch size of the case.
+    std::size_t iterations;    // The number of operations per timed sample.
+    std::size_t sampleCount;   // The number of timed samples.
+    double p50;                // The median duration per operation in ns.
+    double p90;                // The 90th percentile duration per operation in ns.
+    double p99;                // The 99th percentile duration per operation in ns.
+    double mean;               // The mean duration per operation in ns.
+    double throughput;         // The number of items (samples or rows) per second.
+};
+
+/*******************************************************************************
+ * @brief Structure holding the environment in which the benchmarks were run.
+ ******************************************************************************/
+struct Context
+{
+    std::string cpu;            // The CPU model.
+    std::string compiler;       // The compiler version.
+    std::string flags;          // The compiler flags.
+    std::string instructionSet; // The instruction set used by the kernels.
+    std::size_t threadCount;    // The number of threads of the thread pool.
+    std::uint64_t seed;         // The seed of the random number generators.
+};
+
+/*******************************************************************************
+ * @brief Widths of the dense layers to benchmark, each with as many weights
+ *        per node as nodes.
+ ******************************************************************************/
+constexpr std::size_t LayerWidths[]{16U, 64U, 256U, 1024U};
+
+/*******************************************************************************
+ * @brief The minimum duration of one timed sample of a throughput benchmark,
+ *        which keeps the overhead of reading the clock negligible.
+ ******************************************************************************/
+constexpr std::chrono::microseconds MinSampleDuration{100};
+
+// -----------------------------------------------------------------------------
+std::string cpuModel()
+{
+    std::ifstream cpuInfo{"/proc/cpuinfo"};
+    std::string line{};
+
+    while (std::getline(cpuInfo, line))
+    {
+        if (line.rfind("model name", 0U) == 0U)
+        {
+            const auto start{line.find_first_not_of(' ', line.find(':') + 1U)};
+            if (start != std::string::npos) { return line.substr(start); }
+        }
+    }
+    return "unknown";
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+constexpr const char* typeName() noexcept
+{
+    return std::is_same<T, float>::value ? "float" : "double";
+}
+
+// -----------------------------------------------------------------------------
+double percentile(const std::vector<double>& sortedDurations, const double fraction)
+{
+    const auto index{static_cast<std::size_t>(fraction * (sortedDurations.size() - 1U) + 0.5)};
+    return sortedDurations[index];
+}
+
+/*******************************************************************************
+ * @brief Times an operation. The operation is first run until the number of
+ *        iterations per sample covers MinSampleDuration, unless the number of
+ *        iterations is given, in which case each operation is timed on its
+ *        own to provide latency percentiles.
+ *
+ * @tparam T The floating-point type of the benchmarked parameters.
+ *
+ * @param name        The name of the benchmarked operation.
+ * @param size        The layer width or batch size of the case.
+ * @param itemCount   The number of items processed per operation.
+ * @param sampleCount The number of samples to time.
+ * @param operation   The operation to time.
+ * @param iterations  The number of operations per sample (0 = calibrate).
+ *
+ * @return The result of the benchmark.
+ ******************************************************************************/
+template <typename T, typename Operation>
+Result measure(const std::string& name, const std::size_t size, const std::size_t itemCount,
+               const std::size_t sampleCount, const Operation& operation,
+               std::size_t iterations = 0U)
+{
+    operation();
+
+    if (iterations == 0U)
+    {
+        for (iterations = 1U;; iterations *= 2U)
+        {
+            const auto start{Clock::now()};
+            for (std::size_t i{}; i < iterations; ++i) { operation(); }
+            if (Clock::now() - start >= MinSampleDuration) { break; }
+        }
+    }
+    std::vector<double> durations(sampleCount);
+
+    for (auto& duration : durations)
+    {
+        const auto start{Clock::now()};
+        for (std::size_t i{}; i < iterations; ++i) { operation(); }
+        const std::chrono::duration<double, std::nano> elapsed{Clock::now() - start};
+        duration = elapsed.count() / iterations;
+    }
+    std::sort(durations.begin(), durations.end());
+    const auto mean{std::accumulate(durations.begin(), durations.end(), 0.0) / sampleCount};
+
+    return Result{name, typeName<T>(), size, iterations, sampleCount, percentile(durations, 0.5),
+                  percentile(durations, 0.9), percentile(durations, 0.99), mean,
+                  itemCount * 1e9 / mean};
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void benchmarkLayers(std::vector<Result>& results)
+{
+    for (const auto width : LayerWidths)
+    {
+        auto layer{ml::factory::denseLayer<T>(width, width)};
+        auto nextLayer{ml::factory::denseLayer<T>(width, width)};
+        const auto input{ml::factory::randomParameterVector<T>(width)};
+        const auto reference{ml::factory::randomParameterVector<T>(width)};
+        (*layer).feedforwardForTraining(input);
+        (*nextLayer).feedforwardForTraining((*layer).output());
+        (*nextLayer).backpropagate(reference);
+
+        results.push_back(measure<T>("layer_feedforward", width, 1U, 200U,
+                                     [&] { (*layer).feedforwardForTraining(input); }));
+        results.push_back(measure<T>("layer_backpropagate", width, 1U, 200U,
+                                     [&] { (*nextLayer).backpropagate(reference); }));
+
+        // Hidden layers propagate the error of the next layer through its 
+        // transposed weights.
+        results.push_back(measure<T>("layer_backpropagate_hidden", width, 1U, 200U,
+                                     [&] { (*layer).backpropagate(*nextLayer); }));
+
+        // The learning rate is kept small so that the weights barely change.
+        results.push_back(measure<T>("layer_optimize", width, 1U, 200U,
+                                     [&] { (*layer).optimize(input, T{1e-9}); }));
+
+        const auto batch{ml::factory::randomParameterMatrix<T>(64U, width)};
+        ml::Matrix<T> output{};
+        results.push_back(measure<T>("layer_feedforward_batch", width, batch.rowCount(), 200U,
+                                     [&] { (*layer).feedforward(batch, output); }));
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void benchmarkTraining(std::vector<Result>& results)
+{
+    constexpr std::size_t setCount{4096U}, inputCount{16U}, outputCount{4U};
+    auto network{ml::factory::neuralNetwork<T>(inputCount, 64U, outputCount)};
+    (*network).addTrainingSets(
+        ml::factory::randomParameterVector<T>(setCount, inputCount, T{0}, T{1}),
+        ml::factory::randomParameterVector<T>(setCount, outputCount, T{0}, T{1}));
+    const auto threadCount{utils::ThreadPool::instance().threadCount()};
+
+    results.push_back(measure<T>("train", 1U, setCount, 10U,
+                                 [&] { (*network).train(1U, T{0.001}); }, 1U));
+    results.push_back(measure<T>("train_batch", 32U, setCount, 10U,
+                                 [&] { (*network).train(1U, T{0.001}, 32U, threadCount); }, 1U));
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void benchmarkInference(std::vector<Result>& results)
+{
+    auto network{ml::factory::neuralNetwork<T>(16U, 64U, 4U)};
+    const auto input{ml::factory::randomParameterVector<T>(16U)};
+
+    results.push_back(measure<T>("predict", 1U, 1U, 10000U,
+                                 [&] { (*network).predict(input); }, 1U));
+
+    // The static network only supports double, its topology matches the network above.
+    if constexpr (std::is_same_v<T, double>)
+    {
+        ml::StaticNeuralNetwork<16U, 64U, 4U> staticNetwork{};
+        typename decltype(staticNetwork)::Input staticInput{};
+        std::copy(input.begin(), input.end(), staticInput.begin());
+        results.push_back(measure<T>("predict_static", 1U, 1U, 10000U,
+                                     [&] { staticNetwork.predict(staticInput); }, 1U));
+    }
+
+    for (const std::size_t batchSize : {64U, 1024U})
+    {
+        const auto batch{ml::factory::randomParameterMatrix<T>(batchSize, 16U)};
+        ml::Matrix<T> output{};
+        results.push_back(measure<T>("predict_batch", batchSize, batchSize, 1000U,
+                                     [&] { (*network).predict(batch, output); }, 1U));
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void benchmarkAll(std::vector<Result>& results)
+{
+    benchmarkLayers<T>(results);
+    benchmarkTraining<T>(results);
+    benchmarkInference<T>(results);
+}
+
+// -----------------------------------------------------------------------------
+std::string quoted(const std::string& text)
+{
+    std::string result{"\""};
+
+    for (const auto character : text)
+    {
+        if ((character == '"') || (character == '\\')) { result += '\\'; }
+        result += character;
+    }
+    return result + "\"";
+}
+
+// -----------------------------------------------------------------------------
+std::string csvField(const std::string& text)
+{
+    std::string result{"\""};
+
+    for (const auto character : text)
+    {
+        if (character == '"') { result += '"'; }
+        result += character;
+    }
+    return result + "\"";
+}
+
+// -----------------------------------------------------------------------------
+void printCsv(const Context& context, const std::vector<Result>& results)
+{
+    std::cout << "cpu,compiler,flags,instruction_set,threads,seed,benchmark,type,size,"
+              << "iterations,samples,p50_ns,p90_ns,p99_ns,mean_ns,items_per_second\n";
+
+    for (const auto& result : results)
+    {
+        std::cout << csvField(context.cpu) << "," << csvField(context.compiler) << ","
+                  << csvField(context.flags) << "," << context.instructionSet << ","
+                  << context.threadCount << "," << context.seed << "," << result.name << ","
+                  << result.type << ","
+                  << result.size << "," << result.iterations << "," << result.sampleCount << ","
+                  << result.p50 << "," << result.p90 << "," << result.p99 << ","
+                  << result.mean << "," << result.throughput << "\n";
+    }
+}
+
+// -----------------------------------------------------------------------------
+void printJson(const Context& context, const std::vector<Result>& results)
+{
+    std::cout << "{\n  \"context\": {\"cpu\": " << quoted(context.cpu)
+              << ", \"compiler\": " << quoted(context.compiler)
+              << ", \"flags\": " << quoted(context.flags)
+              << ", \"instruction_set\": " << quoted(context.instructionSet)
+              << ", \"threads\": " << context.threadCount
+              << ", \"seed\": " << context.seed << "},\n  \"results\": [";
+
+    for (std::size_t i{}; i < results.size(); ++i)
+    {
+        const auto& result{results[i]};
+        std::cout << (i == 0U ? "\n" : ",\n") << "    {\"benchmark\": " << quoted(result.name)
+                  << ", \"type\": " << quoted(result.type)
+                  << ", \"size\": " << result.size << ", \"iterations\": " << result.iterations
+                  << ", \"samples\": " << result.sampleCount << ", \"p50_ns\": " << result.p50
+                  << ", \"p90_ns\": " << result.p90 << ", \"p99_ns\": " << result.p99
+                  << ", \"mean_ns\": " << result.mean
+                  << ", \"items_per_second\": " << result.throughput << "}";
+    }
+    std::cout << "\n  ]\n}\n";
+}
+
+} // namespace
+
+/*******************************************************************************
+ * @brief Benchmarks single-sample feedforward, backpropagation of output and
+ *        hidden layers and optimization as well as batch feedforward of dense
+ *        layers of different widths, training throughput in training sets per
+ *        second and the latency of single and batch predictions, including the
+ *        static network. Every case is run for both double and float
+ *        parameters, except the static network, which only supports double.
+ *
+ *        Each result holds the median, 90th and 99th percentile and mean
+ *        duration per operation along with the CPU model, the compiler
+ *        version and flags, the instruction set used by the kernels and the
+ *        number of threads, so that results of different library versions
+ *        can be compared. The random number generators are seeded so that
+ *        every run uses the same parameters and data.
+ *
+ *        Usage: benchmark [format (csv or json)] [seed]
+ *
+ * @param argumentCount The number of command line arguments.
+ * @param arguments     The command line arguments.
+ *
+ * @return Success code 0 upon termination of the program, or 1 if the
+ *         format is invalid.
+ ******************************************************************************/
+int main(int argumentCount, char** arguments)
+{
+    const std::string format{argumentCount > 1 ? arguments[1] : "csv"};
+    const std::uint64_t seed{argumentCount > 2 ? std::stoull(arguments[2]) : 1U};
+
+    if ((format != "csv") && (format != "json"))
+    {
+        std::cerr << "Invalid format " << format << ", expected csv or json!\n";
+        return 1;
+    }
+    utils::random::seed(seed);
+
+    const Context context{cpuModel(), __VERSION__, BENCHMARK_FLAGS,
+                          ml::kernels::instructionSetName(ml::kernels::instructionSet()),
+                          utils::ThreadPool::instance().threadCount(), seed};
+    std::vector<Result> results{};
+    benchmarkAll<double>(results);
+    benchmarkAll<float>(results);
+
+    if (format == "json") { printJson(context, results); }
+    else { printCsv(context, results); }
+    return 0;
+}
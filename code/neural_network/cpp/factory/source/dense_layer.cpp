@@ -1,22 +1,44 @@
 /*******************************************************************************
  * @brief Implementation details of the ml::DenseLayer class.
  ******************************************************************************/
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
 #include "act_func_calc.h"
 #include "dense_layer.h"
 #include "factory.h"
+#include "kernels.h"
+#include "thread_pool.h"
 #include "utils.h"
 
+namespace
+{
+
+/*******************************************************************************
+ * @brief The number of inputs processed per block during batch feedforward.
+ *        A block of inputs is kept in cache while every weight row is applied
+ *        to it, so that large batches are not streamed from memory once per node.
+ ******************************************************************************/
+constexpr std::size_t FeedforwardBlockSize{64U};
+
+} // namespace
+
 namespace ml
 {
 
 // -----------------------------------------------------------------------------
-DenseLayer::DenseLayer(const std::size_t nodeCount, const std::size_t weightCount,
-                       const ActFunc actFunc)
-    : myOutput{factory::parameterVector(nodeCount)}
-    , myError{factory::parameterVector(nodeCount)}
-    , myBias{factory::randomParameterVector(nodeCount)}
-    , myWeights{factory::randomParameterVector(nodeCount, weightCount)}
-    , myActFuncCalc{factory::actFuncCalc(actFunc)}
+template <typename T>
+DenseLayer<T>::DenseLayer(const std::size_t nodeCount, const std::size_t weightCount,
+                          const ActFunc actFunc, const TanhPrecision tanhPrecision)
+    : myOutput{factory::parameterVector<T>(nodeCount)}
+    , myError{factory::parameterVector<T>(nodeCount)}
+    , myGradient{factory::parameterVector<T>(nodeCount)}
+    , myBias{factory::randomParameterVector<T>(nodeCount)}
+    , myWeights{factory::randomParameterMatrix<T>(nodeCount, weightCount)}
+    , myActFuncCalc{factory::actFuncCalc<T>(actFunc, tanhPrecision)}
+    , myGradientCaching{true}
+    , myGradientCached{false}
 {
     if (nodeCount == 0U) 
     {
@@ -29,51 +51,129 @@ DenseLayer::DenseLayer(const std::size_t nodeCount, const std::size_t weightCoun
 }
 
 // -----------------------------------------------------------------------------
-const std::vector<double>& DenseLayer::output() const { return myOutput; }
+template <typename T>
+DenseLayer<T>::DenseLayer(std::vector<T> bias, Matrix<T> weights, 
+                          const ActFunc actFunc, const TanhPrecision tanhPrecision)
+    : myOutput{factory::parameterVector<T>(bias.size())}
+    , myError{factory::parameterVector<T>(bias.size())}
+    , myGradient{}
+    , myBias{std::move(bias)}
+    , myWeights{std::move(weights)}
+    , myActFuncCalc{factory::actFuncCalc<T>(actFunc, tanhPrecision)}
+    , myGradientCaching{false}
+    , myGradientCached{false}
+{
+    if (myBias.empty()) 
+    {
+        throw std::invalid_argument("Cannot create dense layer without nodes!");
+    }
+    if (myWeights.columnCount() == 0U)
+    {
+        throw std::invalid_argument("Cannot create dense layer without weights!");
+    }
+    if (myWeights.rowCount() != myBias.size())
+    {
+        throw std::invalid_argument("Mismatching bias and weights!");
+    }
+}
 
 // -----------------------------------------------------------------------------
-const std::vector<double>& DenseLayer::error() const { return myError; }
+template <typename T>
+const std::vector<T>& DenseLayer<T>::output() const { return myOutput; }
 
 // -----------------------------------------------------------------------------
-const std::vector<double>& DenseLayer::bias() const { return myBias; }
+template <typename T>
+const std::vector<T>& DenseLayer<T>::error() const { return myError; }
 
 // -----------------------------------------------------------------------------
-const std::vector<std::vector<double>>& DenseLayer::weights() const { return myWeights; }
+template <typename T>
+const std::vector<T>& DenseLayer<T>::bias() const { return myBias; }
 
 // -----------------------------------------------------------------------------
-ActFunc DenseLayer::actFunc() const { return (*myActFuncCalc).actFunc(); }
+template <typename T>
+const Matrix<T>& DenseLayer<T>::weights() const { return myWeights; }
 
 // -----------------------------------------------------------------------------
-std::size_t DenseLayer::nodeCount() const { return myOutput.size(); }
+template <typename T>
+ActFunc DenseLayer<T>::actFunc() const { return (*myActFuncCalc).actFunc(); }
 
 // -----------------------------------------------------------------------------
-std::size_t DenseLayer::weightCount() const 
+template <typename T>
+TanhPrecision DenseLayer<T>::tanhPrecision() const 
 { 
-    return myWeights.size() > 0U ? myWeights[0U].size() : 0U; 
+    return (*myActFuncCalc).tanhPrecision(); 
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t DenseLayer<T>::nodeCount() const { return myOutput.size(); }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t DenseLayer<T>::weightCount() const { return myWeights.columnCount(); }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+bool DenseLayer<T>::gradientCaching() const { return myGradientCaching; }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void DenseLayer<T>::setGradientCaching(const bool enable)
+{
+    myGradientCaching = enable;
+    myGradientCached  = false;
+
+    if (enable) { myGradient.resize(nodeCount()); }
+    else
+    {
+        myGradient.clear();
+        myGradient.shrink_to_fit();
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void DenseLayer<T>::feedforward(const std::vector<T>& input)
+{
+    feedforward(input, myOutput);
+    myGradientCached = false;
 }
 
 // -----------------------------------------------------------------------------
-void DenseLayer::feedforward(const std::vector<double>& input)
+template <typename T>
+void DenseLayer<T>::feedforwardForTraining(const std::vector<T>& input)
+{
+    feedforward(input, myOutput);
+    myGradientCached = myGradientCaching;
+
+    if (myGradientCached)
+    {
+        (*myActFuncCalc).gradient(myOutput.data(), myGradient.data(), nodeCount());
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void DenseLayer<T>::feedforward(const std::vector<T>& input, std::vector<T>& output) const
 {
     if (input.size() != weightCount())
     {
         throw std::invalid_argument(
             "Feedforward input does not match the shape of the dense layer!");
     }
+    output.resize(nodeCount());
 
     for (std::size_t i{}; i < nodeCount(); ++i)
     {
-        auto sum{myBias[i]};
-        for (std::size_t j{}; j < weightCount(); ++j)
-        {
-            sum += input[j] * myWeights[i][j];
-        }
-        myOutput[i] = (*myActFuncCalc).output(sum);
+        output[i] = myBias[i] + kernels::dot(input.data(), myWeights.row(i).data(), 
+                                             weightCount());
     }
+    (*myActFuncCalc).output(output.data(), output.data(), nodeCount());
 }
 
 // -----------------------------------------------------------------------------
-void DenseLayer::backpropagate(const std::vector<double>& reference)
+template <typename T>
+void DenseLayer<T>::backpropagate(const std::vector<T>& reference)
 {
     if (reference.size() != nodeCount())
     {
@@ -81,15 +181,13 @@ void DenseLayer::backpropagate(const std::vector<double>& reference)
             "Backpropagation reference does not match the shape of the dense layer!");
     }
 
-    for (std::size_t i{}; i < nodeCount(); ++i)
-    {
-        const auto error{reference[i] - myOutput[i]};
-        myError[i] = error * (*myActFuncCalc).gradient(myOutput[i]);
-    }
+    for (std::size_t i{}; i < nodeCount(); ++i) { myError[i] = reference[i] - myOutput[i]; }
+    multiplyGradient();
 }
 
 // -----------------------------------------------------------------------------
-void DenseLayer::backpropagate(const DenseLayerInterface& nextLayer)
+template <typename T>
+void DenseLayer<T>::backpropagate(const DenseLayerInterface<T>& nextLayer)
 {
     if (nextLayer.weightCount() != nodeCount())
     {
@@ -97,19 +195,56 @@ void DenseLayer::backpropagate(const DenseLayerInterface& nextLayer)
             "The shape of the next layer does not match the current layer!");
     }
 
+    // The next layer is only accessed once; the product is then calculated directly
+    // on its contiguous storage, accumulating four weight rows at a time.
+    const auto& nextError{nextLayer.error()};
+    const auto& nextWeights{nextLayer.weights()};
+    std::fill(myError.begin(), myError.end(), T{});
+
+    kernels::transposedProduct(nextError.data(), nextWeights.data(), nextError.size(), 
+                               nextWeights.stride(), myError.data(), nodeCount());
+    multiplyGradient();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void DenseLayer<T>::backpropagateError(const std::vector<T>& propagatedError)
+{
+    if (propagatedError.size() != nodeCount())
+    {
+        throw std::invalid_argument(
+            "The propagated error does not match the shape of the dense layer!");
+    }
+    std::copy(propagatedError.begin(), propagatedError.end(), myError.begin());
+    multiplyGradient();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void DenseLayer<T>::optimize(const std::vector<T>& input, const T learningRate)
+{
+    if (input.size() != weightCount())
+    {
+        throw std::invalid_argument(
+            "Optimization input does not match the shape of the dense layer!");
+    }
+    if (learningRate <= 0.0)
+    {
+        throw std::invalid_argument("The learning rate must exceed 0!");
+    }
+
     for (std::size_t i{}; i < nodeCount(); ++i)
     {
-        double error{};
-        for (std::size_t j{}; j < nextLayer.nodeCount(); ++j)
-        {
-            error += nextLayer.error()[j] * nextLayer.weights()[j][i];
-        }
-        myError[i] = error * (*myActFuncCalc).gradient(myOutput[i]);
+        myBias[i] += myError[i] * learningRate;
+        kernels::axpy(myError[i] * learningRate, input.data(), myWeights.row(i).data(), 
+                      weightCount());
     }
 }
 
 // -----------------------------------------------------------------------------
-void DenseLayer::optimize(const std::vector<double>& input, const double learningRate)
+template <typename T>
+void DenseLayer<T>::optimize(const std::vector<T>& input, const T learningRate, 
+                             std::vector<T>& inputError)
 {
     if (input.size() != weightCount())
     {
@@ -120,19 +255,155 @@ void DenseLayer::optimize(const std::vector<double>& input, const double learnin
     {
         throw std::invalid_argument("The learning rate must exceed 0!");
     }
+    inputError.assign(weightCount(), T{});
 
     for (std::size_t i{}; i < nodeCount(); ++i)
     {
         myBias[i] += myError[i] * learningRate;
-        for (std::size_t j{}; j < weightCount(); ++j)
+        kernels::fusedAxpy(myError[i], myError[i] * learningRate, input.data(), 
+                           myWeights.row(i).data(), inputError.data(), weightCount());
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void DenseLayer<T>::feedforward(const Matrix<T>& input, Matrix<T>& output) const
+{
+    if (input.columnCount() != weightCount())
+    {
+        throw std::invalid_argument(
+            "Feedforward input does not match the shape of the dense layer!");
+    }
+    output.resize(input.rowCount(), nodeCount());
+
+    // Calculates output = input * weights^T + bias one block of inputs at a time. Within
+    // a block, each weight row is applied to every input while both are in cache. The
+    // blocks write disjoint rows of the output and are therefore run in parallel.
+    utils::ThreadPool::instance().parallelFor(0U, input.rowCount(), FeedforwardBlockSize, 
+        [&](const std::size_t first, const std::size_t last)
+    {
+        for (std::size_t i{}; i < nodeCount(); ++i)
+        {
+            const auto* weights{myWeights.row(i).data()};
+
+            for (std::size_t k{first}; k < last; ++k)
+            {
+                output.row(k)[i] = myBias[i] + kernels::dot(input.row(k).data(), weights, 
+                                                            weightCount());
+            }
+        }
+        for (std::size_t k{first}; k < last; ++k)
         {
-            myWeights[i][j] += myError[i] * learningRate * input[j];
+            auto outputs{output.row(k)};
+            (*myActFuncCalc).output(outputs.data(), outputs.data(), nodeCount());
         }
+    });
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void DenseLayer<T>::backpropagate(const Matrix<T>& output, const Matrix<T>& reference, 
+                                  Matrix<T>& error) const
+{
+    if ((reference.columnCount() != nodeCount()) || (output.columnCount() != nodeCount()) ||
+        (reference.rowCount() != output.rowCount()))
+    {
+        throw std::invalid_argument(
+            "Backpropagation reference does not match the shape of the dense layer!");
+    }
+    error.resize(output.rowCount(), nodeCount());
+
+    for (std::size_t k{}; k < output.rowCount(); ++k)
+    {
+        const auto outputs{output.row(k)};
+        const auto references{reference.row(k)};
+        auto errors{error.row(k)};
+
+        for (std::size_t i{}; i < nodeCount(); ++i) { errors[i] = references[i] - outputs[i]; }
+        (*myActFuncCalc).multiplyGradient(outputs.data(), errors.data(), nodeCount());
     }
 }
 
 // -----------------------------------------------------------------------------
-void DenseLayer::print(std::ostream& ostream, const std::size_t decimalCount) const
+template <typename T>
+void DenseLayer<T>::backpropagate(const Matrix<T>& output, 
+                                  const DenseLayerInterface<T>& nextLayer,
+                                  const Matrix<T>& nextError, Matrix<T>& error) const
+{
+    if ((nextLayer.weightCount() != nodeCount()) || (output.columnCount() != nodeCount()) ||
+        (nextError.columnCount() != nextLayer.nodeCount()) || 
+        (nextError.rowCount() != output.rowCount()))
+    {
+        throw std::invalid_argument(
+            "The shape of the next layer does not match the current layer!");
+    }
+    const auto& nextWeights{nextLayer.weights()};
+    error.resize(output.rowCount(), nodeCount());
+
+    // Calculates error = nextError * nextWeights row by row for unit-stride access.
+    for (std::size_t k{}; k < output.rowCount(); ++k)
+    {
+        const auto outputs{output.row(k)};
+        auto errors{error.row(k)};
+
+        kernels::transposedProduct(nextError.row(k).data(), nextWeights.data(), 
+                                   nextError.columnCount(), nextWeights.stride(), 
+                                   errors.data(), nodeCount());
+        (*myActFuncCalc).multiplyGradient(outputs.data(), errors.data(), nodeCount());
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void DenseLayer<T>::accumulateGradients(const Matrix<T>& input, const Matrix<T>& error,
+                                        std::vector<T>& biasGradient, 
+                                        Matrix<T>& weightGradient) const
+{
+    if ((input.columnCount() != weightCount()) || (error.columnCount() != nodeCount()) ||
+        (input.rowCount() != error.rowCount()))
+    {
+        throw std::invalid_argument(
+            "Gradient input does not match the shape of the dense layer!");
+    }
+    checkGradientShape(biasGradient, weightGradient);
+
+    // Calculates weightGradient += error^T * input one weight row at a time.
+    for (std::size_t i{}; i < nodeCount(); ++i)
+    {
+        auto* gradients{weightGradient.row(i).data()};
+
+        for (std::size_t k{}; k < input.rowCount(); ++k)
+        {
+            const auto nodeError{error.row(k)[i]};
+            biasGradient[i] += nodeError;
+            kernels::axpy(nodeError, input.row(k).data(), gradients, weightCount());
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void DenseLayer<T>::optimize(const std::vector<T>& biasGradient, 
+                             const Matrix<T>& weightGradient, 
+                             const T learningRate)
+{
+    checkGradientShape(biasGradient, weightGradient);
+    if (learningRate <= 0.0)
+    {
+        throw std::invalid_argument("The learning rate must exceed 0!");
+    }
+
+    for (std::size_t i{}; i < nodeCount(); ++i)
+    {
+        myBias[i] += biasGradient[i] * learningRate;
+        kernels::axpy(learningRate, weightGradient.row(i).data(), myWeights.row(i).data(), 
+                      weightCount());
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void DenseLayer<T>::print(std::ostream& ostream, const std::size_t decimalCount) const
 {
     ostream << "--------------------------------------------------------------------------------\n";
     ostream << "Output:\t\t\t";
@@ -142,9 +413,39 @@ void DenseLayer::print(std::ostream& ostream, const std::size_t decimalCount) co
     ostream << "Bias:\t\t\t";
     utils::vector::print(myBias, ostream, "\n", decimalCount);
     ostream << "Weights:\t\t";
-    utils::vector::print(myWeights, ostream, "\n", decimalCount);
+    myWeights.print(ostream, "\n", decimalCount);
     ostream << "Activation function:\t" << (*myActFuncCalc).actFuncName() << "\n";
     ostream << "--------------------------------------------------------------------------------\n\n";
 }
 
+// -----------------------------------------------------------------------------
+template <typename T>
+void DenseLayer<T>::checkGradientShape(const std::vector<T>& biasGradient, 
+                                       const Matrix<T>& weightGradient) const
+{
+    if ((biasGradient.size() != nodeCount()) || (weightGradient.rowCount() != nodeCount()) ||
+        (weightGradient.columnCount() != weightCount()))
+    {
+        throw std::invalid_argument(
+            "The shape of the gradients does not match the dense layer!");
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void DenseLayer<T>::multiplyGradient()
+{
+    if (myGradientCached)
+    {
+        for (std::size_t i{}; i < nodeCount(); ++i) { myError[i] *= myGradient[i]; }
+    }
+    else
+    {
+        (*myActFuncCalc).multiplyGradient(myOutput.data(), myError.data(), nodeCount());
+    }
+}
+
+template class DenseLayer<float>;
+template class DenseLayer<double>;
+
 } // namespace ml
\ No newline at end of file
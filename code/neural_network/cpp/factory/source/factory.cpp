@@ -1,9 +1,12 @@
 /*******************************************************************************
  * @brief Implementation details of machine learning factory.
  ******************************************************************************/
+#include <stdexcept>
+
 #include "dense_layer.h"
 #include "factory.h"
 #include "neural_network.h"
+#include "random_generator.h"
 #include "utils.h"
 
 namespace ml
@@ -12,67 +15,163 @@ namespace factory
 {
 
 // -----------------------------------------------------------------------------
-std::unique_ptr<NeuralNetworkInterface> neuralNetwork(const std::size_t inputCount, 
-                                                      const std::size_t hiddenNodesCount,
-                                                      const std::size_t outputCount, 
-                                                      const ActFunc actFuncHidden, 
-                                                      const ActFunc actFuncOutput)
+template <typename T>
+std::unique_ptr<NeuralNetworkInterface<T>> neuralNetwork(const std::size_t inputCount, 
+                                                         const std::size_t hiddenNodesCount,
+                                                         const std::size_t outputCount, 
+                                                         const ActFunc actFuncHidden, 
+                                                         const ActFunc actFuncOutput,
+                                                         const TanhPrecision tanhPrecision)
+{
+    return std::unique_ptr<NeuralNetworkInterface<T>>{
+        std::make_unique<NeuralNetwork<T>>(inputCount, hiddenNodesCount, outputCount, 
+                                           actFuncHidden, actFuncOutput, tanhPrecision)};
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::unique_ptr<QuantizedNetwork<T>> quantizedNetwork(const NeuralNetworkInterface<T>& network)
 {
-    return std::unique_ptr<NeuralNetworkInterface>{
-        std::make_unique<NeuralNetwork>(inputCount, hiddenNodesCount, outputCount, 
-                                        actFuncHidden,actFuncOutput)};
+    return std::make_unique<QuantizedNetwork<T>>(network);
 }
 
 // -----------------------------------------------------------------------------
-std::unique_ptr<DenseLayerInterface> denseLayer(const std::size_t nodeCount, 
-                                                const std::size_t weightCount,
-                                                const ActFunc actFunc)
+template <typename T>
+std::unique_ptr<DenseLayerInterface<T>> denseLayer(const std::size_t nodeCount, 
+                                                   const std::size_t weightCount,
+                                                   const ActFunc actFunc,
+                                                   const TanhPrecision tanhPrecision)
 {
-    return std::unique_ptr<DenseLayerInterface>{
-        std::make_unique<DenseLayer>(nodeCount, weightCount, actFunc)};
+    return std::unique_ptr<DenseLayerInterface<T>>{
+        std::make_unique<DenseLayer<T>>(nodeCount, weightCount, actFunc, tanhPrecision)};
 }
 
 // -----------------------------------------------------------------------------
-std::unique_ptr<ActFuncCalc> actFuncCalc(const ActFunc actFunc)
+template <typename T>
+std::unique_ptr<ActFuncCalc<T>> actFuncCalc(const ActFunc actFunc, 
+                                            const TanhPrecision tanhPrecision)
 {
-    return std::make_unique<ActFuncCalc>(actFunc);
+    return std::make_unique<ActFuncCalc<T>>(actFunc, tanhPrecision);
 }
 
 // -----------------------------------------------------------------------------
-std::vector<double> parameterVector(const std::size_t size, 
-                                    const double startValue)
+template <typename T>
+std::vector<T> parameterVector(const std::size_t size, 
+                               const T startValue)
 {
-    return std::vector<double>(size, startValue);
+    return std::vector<T>(size, startValue);
 }
 
 // -----------------------------------------------------------------------------
-std::vector<std::vector<double>> parameterVector(const std::size_t columnCount,
-                                                 const std::size_t rowCount,
-                                                 const double startValue)
+template <typename T>
+std::vector<std::vector<T>> parameterVector(const std::size_t columnCount,
+                                            const std::size_t rowCount,
+                                            const T startValue)
 {
-    return std::vector<std::vector<double>>(columnCount, std::vector<double>(rowCount, startValue));
+    return std::vector<std::vector<T>>(columnCount, std::vector<T>(rowCount, startValue));
 }
 
 // -----------------------------------------------------------------------------
-std::vector<double> randomParameterVector(const std::size_t size, 
-                                          const double min, 
-                                          const double max)
+template <typename T>
+std::vector<T> randomParameterVector(const std::size_t size, 
+                                     const T min, 
+                                     const T max)
 {
-    std::vector<double> parameters{};
-    utils::vector::initRandom<double>(parameters, size, min, max);
+    std::vector<T> parameters{};
+    utils::vector::initRandom<T>(parameters, size, min, max);
     return parameters;
 }
 
 // -----------------------------------------------------------------------------
-std::vector<std::vector<double>> randomParameterVector(const std::size_t columnCount,
-                                                       const std::size_t rowCount,
-                                                       const double min, 
-                                                       const double max)
+template <typename T>
+std::vector<std::vector<T>> randomParameterVector(const std::size_t columnCount,
+                                                  const std::size_t rowCount,
+                                                  const T min, 
+                                                  const T max)
 {
-    std::vector<std::vector<double>> parameters{};
-    utils::vector::initRandom<double>(parameters, columnCount, rowCount, min, max);
+    std::vector<std::vector<T>> parameters{};
+    utils::vector::initRandom<T>(parameters, columnCount, rowCount, min, max);
     return parameters;
 }
 
+// -----------------------------------------------------------------------------
+template <typename T>
+Matrix<T> parameterMatrix(const std::size_t rowCount,
+                          const std::size_t columnCount,
+                          const T startValue)
+{
+    return Matrix<T>{rowCount, columnCount, startValue};
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+Matrix<T> randomParameterMatrix(const std::size_t rowCount,
+                                const std::size_t columnCount,
+                                const T min, 
+                                const T max)
+{
+    if ((rowCount == 0U) || (columnCount == 0U))
+    {
+        throw std::invalid_argument(
+            "Matrix row and column count must both exceed 0 for random initialization!");
+    }
+    if (min > max)
+    {
+        throw std::invalid_argument(
+            "Cannot generate random number when min is more than max!");
+    }
+    Matrix<T> parameters{rowCount, columnCount};
+    auto& generator{utils::RandomGenerator::local()};
+
+    for (std::size_t i{}; i < rowCount; ++i)
+    {
+        for (auto& parameter : parameters.row(i)) 
+        { 
+            parameter = generator.uniform<T>(min, max); 
+        }
+    }
+    return parameters;
+}
+
+template std::unique_ptr<NeuralNetworkInterface<float>> neuralNetwork<float>(
+    const std::size_t, const std::size_t, const std::size_t, const ActFunc, const ActFunc, 
+    const TanhPrecision);
+template std::unique_ptr<QuantizedNetwork<float>> quantizedNetwork<float>(
+    const NeuralNetworkInterface<float>&);
+template std::unique_ptr<DenseLayerInterface<float>> denseLayer<float>(
+    const std::size_t, const std::size_t, const ActFunc, const TanhPrecision);
+template std::unique_ptr<ActFuncCalc<float>> actFuncCalc<float>(
+    const ActFunc, const TanhPrecision);
+template std::vector<float> parameterVector<float>(const std::size_t, const float);
+template std::vector<std::vector<float>> parameterVector<float>(
+    const std::size_t, const std::size_t, const float);
+template std::vector<float> randomParameterVector<float>(
+    const std::size_t, const float, const float);
+template std::vector<std::vector<float>> randomParameterVector<float>(
+    const std::size_t, const std::size_t, const float, const float);
+template Matrix<float> parameterMatrix<float>(const std::size_t, const std::size_t, const float);
+template Matrix<float> randomParameterMatrix<float>(
+    const std::size_t, const std::size_t, const float, const float);
+
+template std::unique_ptr<NeuralNetworkInterface<double>> neuralNetwork<double>(
+    const std::size_t, const std::size_t, const std::size_t, const ActFunc, const ActFunc, 
+    const TanhPrecision);
+template std::unique_ptr<QuantizedNetwork<double>> quantizedNetwork<double>(
+    const NeuralNetworkInterface<double>&);
+template std::unique_ptr<DenseLayerInterface<double>> denseLayer<double>(
+    const std::size_t, const std::size_t, const ActFunc, const TanhPrecision);
+template std::unique_ptr<ActFuncCalc<double>> actFuncCalc<double>(
+    const ActFunc, const TanhPrecision);
+template std::vector<double> parameterVector<double>(const std::size_t, const double);
+template std::vector<std::vector<double>> parameterVector<double>(
+    const std::size_t, const std::size_t, const double);
+template std::vector<double> randomParameterVector<double>(
+    const std::size_t, const double, const double);
+template std::vector<std::vector<double>> randomParameterVector<double>(
+    const std::size_t, const std::size_t, const double, const double);
+template Matrix<double> parameterMatrix<double>(const std::size_t, const std::size_t, const double);
+template Matrix<double> randomParameterMatrix<double>(
+    const std::size_t, const std::size_t, const double, const double);
+
 } // namespace factory
 } // namespace ml
\ No newline at end of file
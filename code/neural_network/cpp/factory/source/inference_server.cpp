@@ -0,0 +1,398 @@
+/*******************************************************************************
+ * @brief Implementation details of the ml::InferenceServer class.
+ ******************************************************************************/
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "inference_server.h"
+
+namespace
+{
+
+/*******************************************************************************
+ * @brief The largest accepted payload of a request in bytes. Clients sending
+ *        larger payloads are disconnected.
+ ******************************************************************************/
+constexpr std::uint32_t MaxPayloadSize{1U << 24U};
+
+/*******************************************************************************
+ * @brief The interval in milliseconds at which the listening socket checks if
+ *        the server has been stopped.
+ ******************************************************************************/
+constexpr int AcceptPollInterval{100};
+
+// -----------------------------------------------------------------------------
+bool readAll(const int socket, void* data, const std::size_t size)
+{
+    auto* bytes{static_cast<char*>(data)};
+    std::size_t count{};
+
+    while (count < size)
+    {
+        const auto received{::recv(socket, bytes + count, size - count, 0)};
+        if (received > 0) { count += static_cast<std::size_t>(received); }
+        else if ((received < 0) && (errno == EINTR)) { continue; }
+        else { return false; }
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+bool writeAll(const int socket, const void* data, const std::size_t size)
+{
+    const auto* bytes{static_cast<const char*>(data)};
+    std::size_t count{};
+
+    while (count < size)
+    {
+        const auto sent{::send(socket, bytes + count, size - count, MSG_NOSIGNAL)};
+        if (sent > 0) { count += static_cast<std::size_t>(sent); }
+        else if ((sent < 0) && (errno == EINTR)) { continue; }
+        else { return false; }
+    }
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+bool sendMessage(const int socket, const ml::MessageType type, const void* payload,
+                 const std::size_t size)
+{
+    const ml::MessageHeader header{type, static_cast<std::uint32_t>(size)};
+    return writeAll(socket, &header, sizeof(header)) && writeAll(socket, payload, size);
+}
+
+// -----------------------------------------------------------------------------
+bool sendText(const int socket, const ml::MessageType type, const std::string& text)
+{
+    return sendMessage(socket, type, text.data(), text.size());
+}
+
+} // namespace
+
+namespace ml
+{
+
+// -----------------------------------------------------------------------------
+template <typename T>
+InferenceServer<T>::InferenceServer(const NeuralNetworkInterface<T>& network,
+                                    const std::string& socketPath,
+                                    const BatchPolicy& policy)
+    : myNetwork{network}
+    , mySocketPath{socketPath}
+    , myPolicy{policy}
+    , myStopRequested{false}
+    , myListener{-1}
+    , myQueueMutex{}
+    , myQueueCondition{}
+    , myDoneCondition{}
+    , myQueue{}
+    , myBatching{false}
+    , myContext{}
+    , myBatchInput{}
+    , myBatchOutput{}
+    , myClientMutex{}
+    , myClientCondition{}
+    , myClients{}
+    , myRunCondition{}
+    , myRunning{false}
+    , myStatsMutex{}
+    , myRequestCount{}
+    , myBatchCount{}
+    , myLatencyHistogram{}
+    , myBatchSizeHistogram(policy.maxBatchSize)
+{
+    if (socketPath.empty() || (socketPath.size() >= sizeof(sockaddr_un::sun_path)))
+    {
+        throw std::invalid_argument("Invalid socket path!");
+    }
+    if (policy.maxBatchSize == 0U)
+    {
+        throw std::invalid_argument("Invalid max batch size 0!");
+    }
+    if (policy.maxLatency.count() < 0)
+    {
+        throw std::invalid_argument("Invalid max latency < 0!");
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+InferenceServer<T>::~InferenceServer()
+{
+    stop();
+
+    // Members used by run must not be destroyed until it has returned.
+    std::unique_lock<std::mutex> lock{myClientMutex};
+    myRunCondition.wait(lock, [this] { return !myRunning; });
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void InferenceServer<T>::run()
+{
+    {
+        std::lock_guard<std::mutex> lock{myClientMutex};
+        myRunning = true;
+    }
+    const int listener{::socket(AF_UNIX, SOCK_STREAM, 0)};
+    if (listener < 0)
+    {
+        finishRun();
+        throw std::system_error(errno, std::generic_category(), "Failed to create socket");
+    }
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::copy(mySocketPath.begin(), mySocketPath.end(), address.sun_path);
+    ::unlink(mySocketPath.c_str());
+
+    if ((::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0) ||
+        (::listen(listener, SOMAXCONN) < 0))
+    {
+        const auto error{errno};
+        ::close(listener);
+        finishRun();
+        throw std::system_error(error, std::generic_category(),
+                                "Failed to listen on " + mySocketPath);
+    }
+    myListener = listener;
+    myBatching = true;
+    std::thread batcher{&InferenceServer::processBatches, this};
+
+    // Polls with a timeout, so that stop is noticed even if no client connects.
+    // A stop requested before this point is kept, so run returns immediately.
+    while (!myStopRequested)
+    {
+        pollfd descriptor{listener, POLLIN, 0};
+        if (::poll(&descriptor, 1U, AcceptPollInterval) <= 0) { continue; }
+        const int client{::accept(listener, nullptr, nullptr)};
+        if (client < 0) { continue; }
+
+        std::lock_guard<std::mutex> lock{myClientMutex};
+        if (myStopRequested)
+        {
+            ::close(client);
+            break;
+        }
+        myClients.insert(client);
+        std::thread{&InferenceServer::serve, this, client}.detach();
+    }
+    stop();
+
+    // Pending requests are answered before the batching thread is stopped.
+    {
+        std::unique_lock<std::mutex> lock{myClientMutex};
+        myClientCondition.wait(lock, [this] { return myClients.empty(); });
+    }
+    {
+        std::lock_guard<std::mutex> lock{myQueueMutex};
+        myBatching = false;
+    }
+    myQueueCondition.notify_all();
+    batcher.join();
+
+    myListener = -1;
+    ::close(listener);
+    ::unlink(mySocketPath.c_str());
+    finishRun();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void InferenceServer<T>::stop()
+{
+    myStopRequested = true;
+    std::lock_guard<std::mutex> lock{myClientMutex};
+
+    // Wakes up client threads blocked on reading their next request.
+    for (const auto& client : myClients) { ::shutdown(client, SHUT_RD); }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::string InferenceServer<T>::stats() const
+{
+    std::lock_guard<std::mutex> lock{myStatsMutex};
+    std::ostringstream json{};
+
+    json << "{\"requests\": " << myRequestCount << ", \"batches\": " << myBatchCount;
+    json << ", \"latency_us\": [";
+
+    for (std::size_t i{}; i < myLatencyHistogram.size(); ++i)
+    {
+        if (i > 0U) { json << ", "; }
+        json << "{\"below\": ";
+        if (i + 1U < myLatencyHistogram.size()) { json << (1ULL << i); }
+        else { json << "null"; }
+        json << ", \"count\": " << myLatencyHistogram[i] << "}";
+    }
+    json << "], \"batch_size\": [";
+
+    for (std::size_t i{}; i < myBatchSizeHistogram.size(); ++i)
+    {
+        if (i > 0U) { json << ", "; }
+        json << "{\"size\": " << i + 1U << ", \"count\": " << myBatchSizeHistogram[i] << "}";
+    }
+    json << "]}";
+    return json.str();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void InferenceServer<T>::serve(const int client)
+{
+    const auto inputCount{myNetwork.inputCount()};
+    MessageHeader header{};
+    std::vector<char> payload{};
+    std::vector<float> values{};
+    Request request{};
+
+    while (readAll(client, &header, sizeof(header)))
+    {
+        const auto received{std::chrono::steady_clock::now()};
+        if (header.size > MaxPayloadSize) { break; }
+        payload.resize(header.size);
+        if (!readAll(client, payload.data(), header.size)) { break; }
+
+        if (header.type == MessageType::Predict)
+        {
+            if (header.size != inputCount * sizeof(float))
+            {
+                if (!sendText(client, MessageType::Error,
+                              "Input does not match the shape of the neural network!"))
+                {
+                    break;
+                }
+                continue;
+            }
+            values.resize(inputCount);
+            std::memcpy(values.data(), payload.data(), header.size);
+            request.input.assign(values.begin(), values.end());
+            request.received = received;
+            predict(request);
+
+            values.assign(request.output.begin(), request.output.end());
+            if (!sendMessage(client, MessageType::Output, values.data(),
+                             values.size() * sizeof(float)))
+            {
+                break;
+            }
+            recordLatency(received);
+        }
+        else if (header.type == MessageType::Stats)
+        {
+            if (!sendText(client, MessageType::Report, stats())) { break; }
+        }
+        else if (!sendText(client, MessageType::Error, "Unknown message type!")) { break; }
+    }
+    ::close(client);
+
+    std::lock_guard<std::mutex> lock{myClientMutex};
+    myClients.erase(client);
+    myClientCondition.notify_all();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void InferenceServer<T>::processBatches()
+{
+    std::vector<Request*> batch{};
+    batch.reserve(myPolicy.maxBatchSize);
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock{myQueueMutex};
+            myQueueCondition.wait(lock, [this] { return !myQueue.empty() || !myBatching; });
+            if (myQueue.empty()) { return; }
+
+            // Waits for a full batch until the oldest request reaches the max latency.
+            const auto deadline{myQueue.front()->received + myPolicy.maxLatency};
+            myQueueCondition.wait_until(lock, deadline, [this]
+            {
+                return (myQueue.size() >= myPolicy.maxBatchSize) || !myBatching;
+            });
+            const auto count{std::min(myQueue.size(), myPolicy.maxBatchSize)};
+            batch.assign(myQueue.begin(), myQueue.begin() + count);
+            myQueue.erase(myQueue.begin(), myQueue.begin() + count);
+        }
+        myBatchInput.resize(batch.size(), myNetwork.inputCount());
+
+        for (std::size_t i{}; i < batch.size(); ++i)
+        {
+            std::copy((*batch[i]).input.begin(), (*batch[i]).input.end(),
+                      myBatchInput.row(i).data());
+        }
+        myNetwork.predict(myBatchInput, myBatchOutput, myContext);
+
+        for (std::size_t i{}; i < batch.size(); ++i)
+        {
+            const auto* output{myBatchOutput.row(i).data()};
+            (*batch[i]).output.assign(output, output + myBatchOutput.columnCount());
+        }
+        {
+            std::lock_guard<std::mutex> lock{myStatsMutex};
+            ++myBatchCount;
+            ++myBatchSizeHistogram[batch.size() - 1U];
+        }
+        {
+            std::lock_guard<std::mutex> lock{myQueueMutex};
+            for (auto* request : batch) { (*request).done = true; }
+        }
+        myDoneCondition.notify_all();
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void InferenceServer<T>::predict(Request& request)
+{
+    std::unique_lock<std::mutex> lock{myQueueMutex};
+    request.done = false;
+    myQueue.push_back(&request);
+    myQueueCondition.notify_one();
+    myDoneCondition.wait(lock, [&request] { return request.done; });
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void InferenceServer<T>::recordLatency(const std::chrono::steady_clock::time_point received)
+{
+    const auto latency{std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - received).count()};
+    std::size_t bucket{};
+
+    while ((bucket + 1U < LatencyBucketCount) &&
+           (static_cast<long long>(1ULL << bucket) <= latency))
+    {
+        ++bucket;
+    }
+    std::lock_guard<std::mutex> lock{myStatsMutex};
+    ++myRequestCount;
+    ++myLatencyHistogram[bucket];
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void InferenceServer<T>::finishRun()
+{
+    // Notifies while holding the lock, since the destructor may delete the
+    // condition as soon as it observes that run has returned.
+    std::lock_guard<std::mutex> lock{myClientMutex};
+    myRunning = false;
+    myRunCondition.notify_all();
+}
+
+template class InferenceServer<float>;
+template class InferenceServer<double>;
+
+} // namespace ml
@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * @brief Local inference server serving a neural network trained to detect
+ *        a 2-bit XOR pattern, or a neural network loaded from a model file.
+ ******************************************************************************/
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "factory.h"
+#include "inference_server.h"
+#include "model_format.h"
+
+namespace
+{
+
+/*******************************************************************************
+ * @brief The command line usage of the inference server.
+ ******************************************************************************/
+constexpr auto Usage{"Usage: inference_server [socket path] [max batch size] "
+                     "[max latency in us] [model path]\n"};
+
+// -----------------------------------------------------------------------------
+long parseNumber(const char* argument, const long min)
+{
+    char* end{};
+    const auto number{std::strtol(argument, &end, 10)};
+
+    if ((end == argument) || (*end != '\0') || (number < min))
+    {
+        throw std::invalid_argument("Invalid argument " + std::string{argument} + "!");
+    }
+    return number;
+}
+
+} // namespace
+
+/*******************************************************************************
+ * @brief Trains a small neural network to detect a 2-bit XOR pattern, or 
+ *        loads a neural network from a model file if a path is given, and
+ *        serves its predictions over a Unix domain socket until the process
+ *        receives SIGINT or SIGTERM.
+ *
+ *        Usage: inference_server [socket path] [max batch size] 
+ *                                [max latency in us] [model path]
+ *
+ * @param argumentCount The number of command line arguments.
+ * @param arguments     The command line arguments.
+ *
+ * @return Success code 0 upon termination of the program, or 1 if the 
+ *         arguments are invalid or the server could not be started.
+ ******************************************************************************/
+int main(int argumentCount, char** arguments)
+{
+    const std::string socketPath{argumentCount > 1 ? arguments[1] : "/tmp/ml_inference.sock"};
+    ml::BatchPolicy policy{};
+    std::unique_ptr<ml::NeuralNetworkInterface<>> network{};
+
+    // Signals are blocked in every thread and received synchronously below.
+    sigset_t signals{};
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    try
+    {
+        if (argumentCount > 2) { policy.maxBatchSize = parseNumber(arguments[2], 1); }
+        if (argumentCount > 3) 
+        { 
+            policy.maxLatency = std::chrono::microseconds{parseNumber(arguments[3], 0)}; 
+        }
+        if (argumentCount > 4) { network = ml::model::load(arguments[4]); }
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << exception.what() << "\n" << Usage;
+        return 1;
+    }
+
+    const std::vector<std::vector<double>> trainingInput{{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+    const std::vector<std::vector<double>> trainingOutput{{0}, {1}, {1}, {0}};
+
+    if (network == nullptr)
+    {
+        network = ml::factory::neuralNetwork(2, 3, 1, ml::ActFunc::Relu);
+        (*network).addTrainingSets(trainingInput, trainingOutput);
+        while ((*network).train(1000) <= 0.9999);
+    }
+    std::unique_ptr<ml::InferenceServer<>> server{};
+
+    try
+    {
+        server = std::make_unique<ml::InferenceServer<>>(*network, socketPath, policy);
+        std::thread{[server{server.get()}, signals]
+        {
+            int signal{};
+            sigwait(&signals, &signal);
+            (*server).stop();
+        }}.detach();
+
+        std::cout << "Serving predictions on " << socketPath << "\n";
+        (*server).run();
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << exception.what() << "\n";
+        return 1;
+    }
+    std::cout << (*server).stats() << "\n";
+    return 0;
+}
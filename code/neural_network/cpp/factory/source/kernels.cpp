@@ -0,0 +1,1542 @@
+/*******************************************************************************
+ * @brief Implementation details of computation kernels.
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#include "kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ML_KERNELS_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace
+{
+
+/*******************************************************************************
+ * @brief Structure holding pointers to the kernels of one instruction set.
+ ******************************************************************************/
+struct KernelTable
+{
+    double (*dot)(const double*, const double*, std::size_t);          // Dot product.
+    void (*axpy)(const double, const double*, double*, std::size_t);   // y += alpha * x.
+    float (*dotFloat)(const float*, const float*, std::size_t);        // Dot product (float).
+    void (*axpyFloat)(const float, const float*, float*, std::size_t); // y += alpha * x (float).
+    std::int32_t (*dotInt8)(const std::int8_t*, const std::int8_t*, std::size_t); // Int8 dot.
+    void (*fusedAxpy)(const double, const double, const double*, double*, double*, 
+                      std::size_t);                                    // y += a * w, w += b * x.
+    void (*fusedAxpyFloat)(const float, const float, const float*, float*, float*, 
+                           std::size_t);                               // Fused axpy (float).
+    void (*transposedProduct)(const double*, const double*, std::size_t, std::size_t, 
+                              double*, std::size_t);                   // y += A^T * x.
+    void (*transposedProductFloat)(const float*, const float*, std::size_t, std::size_t, 
+                                   float*, std::size_t);               // y += A^T * x (float).
+    void (*relu)(const double*, double*, std::size_t);                 // y = max(x, 0).
+    void (*reluGradient)(const double*, double*, std::size_t);         // y *= x > 0.
+    void (*reluFloat)(const float*, float*, std::size_t);              // y = max(x, 0) (float).
+    void (*reluGradientFloat)(const float*, float*, std::size_t);      // y *= x > 0 (float).
+    void (*tanhGradient)(const double*, double*, std::size_t);         // y *= 1 - x^2.
+    void (*tanhGradientFloat)(const float*, float*, std::size_t);      // y *= 1 - x^2 (float).
+    void (*tanhHigh)(const double*, double*, std::size_t);             // High accuracy tanh.
+    void (*tanhLow)(const double*, double*, std::size_t);              // Low accuracy tanh.
+    void (*tanhHighFloat)(const float*, float*, std::size_t);          // High accuracy (float).
+    void (*tanhLowFloat)(const float*, float*, std::size_t);           // Low accuracy (float).
+};
+
+/*******************************************************************************
+ * @brief Coefficients of the minimax rational [13/6] approximation of tanh, 
+ *        i.e. tanh(x) = x * P(x^2) / Q(x^2) for |x| <= clamp. Beyond the 
+ *        clamp the approximation is within 3e-7 of +-1.
+ ******************************************************************************/
+struct TanhHigh
+{
+    static constexpr double clamp{7.90531110763549805};                     // Clamp of |x|.
+    static constexpr std::size_t numeratorCount{7U};                          // Size of P.
+    static constexpr double numerator[numeratorCount]{4.89352455891786e-03,   // P, lowest
+                                                      6.37261928875436e-04,   // order first.
+                                                      1.48572235717979e-05,
+                                                      5.12229709037114e-08,
+                                                      -8.60467152213735e-11,
+                                                      2.00018790482477e-13,
+                                                      -2.76076847742355e-16};
+    static constexpr double denominator[4U]{4.89352518554385e-03,             // Q, lowest
+                                            2.26843463243900e-03,             // order first.
+                                            1.18534705686654e-04,
+                                            1.19825839466702e-06};
+};
+
+/*******************************************************************************
+ * @brief Coefficients of Lambert's continued fraction of tanh truncated to a
+ *        rational [7/6] function, i.e. tanh(x) = x * P(x^2) / Q(x^2) for 
+ *        |x| <= clamp. The clamp is placed where the error is minimized.
+ ******************************************************************************/
+struct TanhLow
+{
+    static constexpr double clamp{4.97};                                      // Clamp of |x|.
+    static constexpr std::size_t numeratorCount{4U};                          // Size of P.
+    static constexpr double numerator[numeratorCount]{135135.0, 17325.0, 378.0, 1.0}; // P.
+    static constexpr double denominator[4U]{135135.0, 62370.0, 3150.0, 28.0};         // Q.
+};
+
+// -----------------------------------------------------------------------------
+double dotScalar(const double* x, const double* y, const std::size_t size)
+{
+    double sum{};
+    for (std::size_t i{}; i < size; ++i) { sum += x[i] * y[i]; }
+    return sum;
+}
+
+// -----------------------------------------------------------------------------
+void axpyScalar(const double alpha, const double* x, double* y, const std::size_t size)
+{
+    for (std::size_t i{}; i < size; ++i) { y[i] += alpha * x[i]; }
+}
+
+// -----------------------------------------------------------------------------
+float dotScalar(const float* x, const float* y, const std::size_t size)
+{
+    float sum{};
+    for (std::size_t i{}; i < size; ++i) { sum += x[i] * y[i]; }
+    return sum;
+}
+
+// -----------------------------------------------------------------------------
+void axpyScalar(const float alpha, const float* x, float* y, const std::size_t size)
+{
+    for (std::size_t i{}; i < size; ++i) { y[i] += alpha * x[i]; }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void fusedAxpyScalar(const T alpha, const T beta, const T* x, T* w, T* y, 
+                     const std::size_t size)
+{
+    for (std::size_t i{}; i < size; ++i) 
+    { 
+        y[i] += alpha * w[i];
+        w[i] += beta * x[i];
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void axpy4Scalar(const T* alpha, const T* a, const std::size_t stride, T* y, 
+                 const std::size_t size)
+{
+    for (std::size_t i{}; i < size; ++i)
+    {
+        auto sum{y[i]};
+        sum += alpha[0U] * a[i];
+        sum += alpha[1U] * a[stride + i];
+        sum += alpha[2U] * a[2U * stride + i];
+        sum += alpha[3U] * a[3U * stride + i];
+        y[i] = sum;
+    }
+}
+
+/*******************************************************************************
+ * @brief Calculates y += A^T * x by adding four rows of A at a time, so that y 
+ *        is loaded and stored once per four rows. The remaining rows are added 
+ *        one at a time.
+ *
+ * @tparam T      The floating-point type of the sequences.
+ * @tparam Axpy4  Kernel adding four scaled rows to y.
+ * @tparam Axpy   Kernel adding one scaled row to y.
+ ******************************************************************************/
+template <typename T, 
+          void (*Axpy4)(const T*, const T*, std::size_t, T*, std::size_t),
+          void (*Axpy)(T, const T*, T*, std::size_t)>
+void transposedProduct(const T* x, const T* a, const std::size_t rowCount, 
+                       const std::size_t stride, T* y, const std::size_t size)
+{
+    std::size_t j{};
+    for (; j + 4U <= rowCount; j += 4U) { Axpy4(x + j, a + j * stride, stride, y, size); }
+    for (; j < rowCount; ++j) { Axpy(x[j], a + j * stride, y, size); }
+}
+
+// -----------------------------------------------------------------------------
+std::int32_t dotScalar(const std::int8_t* x, const std::int8_t* y, const std::size_t size)
+{
+    std::int32_t sum{};
+    for (std::size_t i{}; i < size; ++i) { sum += x[i] * y[i]; }
+    return sum;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void reluScalar(const T* x, T* y, const std::size_t size)
+{
+    for (std::size_t i{}; i < size; ++i) { y[i] = x[i] > 0 ? x[i] : 0; }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void reluGradientScalar(const T* x, T* y, const std::size_t size)
+{
+    for (std::size_t i{}; i < size; ++i) { y[i] = x[i] > 0 ? y[i] : 0; }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void tanhGradientScalar(const T* x, T* y, const std::size_t size)
+{
+    for (std::size_t i{}; i < size; ++i) { y[i] *= 1 - x[i] * x[i]; }
+}
+
+// -----------------------------------------------------------------------------
+template <typename Tier, typename T>
+void tanhScalar(const T* x, T* y, const std::size_t size)
+{
+    constexpr auto clamp{static_cast<T>(Tier::clamp)};
+
+    for (std::size_t i{}; i < size; ++i)
+    {
+        const auto value{std::clamp(x[i], -clamp, clamp)};
+        const auto square{value * value};
+        auto numerator{static_cast<T>(Tier::numerator[Tier::numeratorCount - 1U])};
+        auto denominator{static_cast<T>(Tier::denominator[3U])};
+
+        for (auto j{Tier::numeratorCount - 1U}; j-- > 0U;)
+        {
+            numerator = numerator * square + static_cast<T>(Tier::numerator[j]);
+        }
+        for (std::size_t j{3U}; j-- > 0U;)
+        {
+            denominator = denominator * square + static_cast<T>(Tier::denominator[j]);
+        }
+        y[i] = value * numerator / denominator;
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void tanhExact(const T* x, T* y, const std::size_t size)
+{
+    for (std::size_t i{}; i < size; ++i) { y[i] = std::tanh(x[i]); }
+}
+
+#ifdef ML_KERNELS_X86
+
+// -----------------------------------------------------------------------------
+__attribute__((target("sse2")))
+double dotSse2(const double* x, const double* y, const std::size_t size)
+{
+    auto sum0{_mm_setzero_pd()};
+    auto sum1{_mm_setzero_pd()};
+    std::size_t i{};
+
+    for (; i + 4U <= size; i += 4U)
+    {
+        sum0 = _mm_add_pd(sum0, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+        sum1 = _mm_add_pd(sum1, _mm_mul_pd(_mm_loadu_pd(x + i + 2U), _mm_loadu_pd(y + i + 2U)));
+    }
+    sum0 = _mm_add_pd(sum0, sum1);
+    sum0 = _mm_add_sd(sum0, _mm_unpackhi_pd(sum0, sum0));
+    auto sum{_mm_cvtsd_f64(sum0)};
+
+    for (; i < size; ++i) { sum += x[i] * y[i]; }
+    return sum;
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("sse2")))
+void axpySse2(const double alpha, const double* x, double* y, const std::size_t size)
+{
+    const auto scale{_mm_set1_pd(alpha)};
+    std::size_t i{};
+
+    for (; i + 2U <= size; i += 2U)
+    {
+        _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i),
+                                        _mm_mul_pd(scale, _mm_loadu_pd(x + i))));
+    }
+    for (; i < size; ++i) { y[i] += alpha * x[i]; }
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("sse2")))
+void fusedAxpySse2(const double alpha, const double beta, const double* x, double* w, 
+                   double* y, const std::size_t size)
+{
+    const auto scaleW{_mm_set1_pd(alpha)};
+    const auto scaleX{_mm_set1_pd(beta)};
+    std::size_t i{};
+
+    for (; i + 2U <= size; i += 2U)
+    {
+        const auto weights{_mm_loadu_pd(w + i)};
+        _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), _mm_mul_pd(scaleW, weights)));
+        _mm_storeu_pd(w + i, _mm_add_pd(weights, _mm_mul_pd(scaleX, _mm_loadu_pd(x + i))));
+    }
+    fusedAxpyScalar(alpha, beta, x + i, w + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("sse2")))
+void axpy4Sse2(const double* alpha, const double* a, const std::size_t stride, double* y, 
+               const std::size_t size)
+{
+    const auto scale0{_mm_set1_pd(alpha[0U])};
+    const auto scale1{_mm_set1_pd(alpha[1U])};
+    const auto scale2{_mm_set1_pd(alpha[2U])};
+    const auto scale3{_mm_set1_pd(alpha[3U])};
+    std::size_t i{};
+
+    for (; i + 2U <= size; i += 2U)
+    {
+        auto sum{_mm_loadu_pd(y + i)};
+        sum = _mm_add_pd(sum, _mm_mul_pd(scale0, _mm_loadu_pd(a + i)));
+        sum = _mm_add_pd(sum, _mm_mul_pd(scale1, _mm_loadu_pd(a + stride + i)));
+        sum = _mm_add_pd(sum, _mm_mul_pd(scale2, _mm_loadu_pd(a + 2U * stride + i)));
+        sum = _mm_add_pd(sum, _mm_mul_pd(scale3, _mm_loadu_pd(a + 3U * stride + i)));
+        _mm_storeu_pd(y + i, sum);
+    }
+    axpy4Scalar(alpha, a + i, stride, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("sse2")))
+float dotSse2(const float* x, const float* y, const std::size_t size)
+{
+    auto sum0{_mm_setzero_ps()};
+    auto sum1{_mm_setzero_ps()};
+    std::size_t i{};
+
+    for (; i + 8U <= size; i += 8U)
+    {
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(x + i + 4U), _mm_loadu_ps(y + i + 4U)));
+    }
+    alignas(16) float lanes[4U];
+    _mm_store_ps(lanes, _mm_add_ps(sum0, sum1));
+    auto sum{(lanes[0U] + lanes[2U]) + (lanes[1U] + lanes[3U])};
+
+    for (; i < size; ++i) { sum += x[i] * y[i]; }
+    return sum;
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("sse2")))
+void axpySse2(const float alpha, const float* x, float* y, const std::size_t size)
+{
+    const auto scale{_mm_set1_ps(alpha)};
+    std::size_t i{};
+
+    for (; i + 4U <= size; i += 4U)
+    {
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i),
+                                        _mm_mul_ps(scale, _mm_loadu_ps(x + i))));
+    }
+    for (; i < size; ++i) { y[i] += alpha * x[i]; }
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("sse2")))
+void fusedAxpySse2(const float alpha, const float beta, const float* x, float* w, 
+                   float* y, const std::size_t size)
+{
+    const auto scaleW{_mm_set1_ps(alpha)};
+    const auto scaleX{_mm_set1_ps(beta)};
+    std::size_t i{};
+
+    for (; i + 4U <= size; i += 4U)
+    {
+        const auto weights{_mm_loadu_ps(w + i)};
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(scaleW, weights)));
+        _mm_storeu_ps(w + i, _mm_add_ps(weights, _mm_mul_ps(scaleX, _mm_loadu_ps(x + i))));
+    }
+    fusedAxpyScalar(alpha, beta, x + i, w + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("sse2")))
+void axpy4Sse2(const float* alpha, const float* a, const std::size_t stride, float* y, 
+               const std::size_t size)
+{
+    const auto scale0{_mm_set1_ps(alpha[0U])};
+    const auto scale1{_mm_set1_ps(alpha[1U])};
+    const auto scale2{_mm_set1_ps(alpha[2U])};
+    const auto scale3{_mm_set1_ps(alpha[3U])};
+    std::size_t i{};
+
+    for (; i + 4U <= size; i += 4U)
+    {
+        auto sum{_mm_loadu_ps(y + i)};
+        sum = _mm_add_ps(sum, _mm_mul_ps(scale0, _mm_loadu_ps(a + i)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(scale1, _mm_loadu_ps(a + stride + i)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(scale2, _mm_loadu_ps(a + 2U * stride + i)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(scale3, _mm_loadu_ps(a + 3U * stride + i)));
+        _mm_storeu_ps(y + i, sum);
+    }
+    axpy4Scalar(alpha, a + i, stride, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("sse2")))
+std::int32_t dotSse2(const std::int8_t* x, const std::int8_t* y, const std::size_t size)
+{
+    auto sum{_mm_setzero_si128()};
+    std::size_t i{};
+
+    // Sign-extends each byte to 16 bits by duplicating it into both halves of a word and
+    // shifting right arithmetically, after which pairs of products are summed in 32 bits.
+    for (; i + 16U <= size; i += 16U)
+    {
+        const auto a{_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i))};
+        const auto b{_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i))};
+        const auto aLow{_mm_srai_epi16(_mm_unpacklo_epi8(a, a), 8)};
+        const auto aHigh{_mm_srai_epi16(_mm_unpackhi_epi8(a, a), 8)};
+        const auto bLow{_mm_srai_epi16(_mm_unpacklo_epi8(b, b), 8)};
+        const auto bHigh{_mm_srai_epi16(_mm_unpackhi_epi8(b, b), 8)};
+        sum = _mm_add_epi32(sum, _mm_add_epi32(_mm_madd_epi16(aLow, bLow), 
+                                               _mm_madd_epi16(aHigh, bHigh)));
+    }
+    alignas(16) std::int32_t lanes[4U];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), sum);
+    auto result{lanes[0U] + lanes[1U] + lanes[2U] + lanes[3U]};
+
+    for (; i < size; ++i) { result += x[i] * y[i]; }
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("sse2")))
+void reluSse2(const double* x, double* y, const std::size_t size)
+{
+    const auto zero{_mm_setzero_pd()};
+    std::size_t i{};
+    for (; i + 2U <= size; i += 2U) { _mm_storeu_pd(y + i, _mm_max_pd(_mm_loadu_pd(x + i), zero)); }
+    reluScalar(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("sse2")))
+void reluGradientSse2(const double* x, double* y, const std::size_t size)
+{
+    const auto zero{_mm_setzero_pd()};
+    std::size_t i{};
+
+    for (; i + 2U <= size; i += 2U)
+    {
+        const auto positive{_mm_cmpgt_pd(_mm_loadu_pd(x + i), zero)};
+        _mm_storeu_pd(y + i, _mm_and_pd(positive, _mm_loadu_pd(y + i)));
+    }
+    reluGradientScalar(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("sse2")))
+void reluSse2(const float* x, float* y, const std::size_t size)
+{
+    const auto zero{_mm_setzero_ps()};
+    std::size_t i{};
+    for (; i + 4U <= size; i += 4U) { _mm_storeu_ps(y + i, _mm_max_ps(_mm_loadu_ps(x + i), zero)); }
+    reluScalar(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("sse2")))
+void reluGradientSse2(const float* x, float* y, const std::size_t size)
+{
+    const auto zero{_mm_setzero_ps()};
+    std::size_t i{};
+
+    for (; i + 4U <= size; i += 4U)
+    {
+        const auto positive{_mm_cmpgt_ps(_mm_loadu_ps(x + i), zero)};
+        _mm_storeu_ps(y + i, _mm_and_ps(positive, _mm_loadu_ps(y + i)));
+    }
+    reluGradientScalar(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("sse2")))
+void tanhGradientSse2(const double* x, double* y, const std::size_t size)
+{
+    const auto one{_mm_set1_pd(1.0)};
+    std::size_t i{};
+
+    for (; i + 2U <= size; i += 2U)
+    {
+        const auto output{_mm_loadu_pd(x + i)};
+        const auto gradient{_mm_sub_pd(one, _mm_mul_pd(output, output))};
+        _mm_storeu_pd(y + i, _mm_mul_pd(_mm_loadu_pd(y + i), gradient));
+    }
+    tanhGradientScalar(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("sse2")))
+void tanhGradientSse2(const float* x, float* y, const std::size_t size)
+{
+    const auto one{_mm_set1_ps(1.0f)};
+    std::size_t i{};
+
+    for (; i + 4U <= size; i += 4U)
+    {
+        const auto output{_mm_loadu_ps(x + i)};
+        const auto gradient{_mm_sub_ps(one, _mm_mul_ps(output, output))};
+        _mm_storeu_ps(y + i, _mm_mul_ps(_mm_loadu_ps(y + i), gradient));
+    }
+    tanhGradientScalar(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+template <typename Tier>
+__attribute__((target("sse2")))
+void tanhSse2(const double* x, double* y, const std::size_t size)
+{
+    const auto upper{_mm_set1_pd(Tier::clamp)};
+    const auto lower{_mm_set1_pd(-Tier::clamp)};
+    std::size_t i{};
+
+    // The bounds are passed as first operands so that NaN propagates through the clamp.
+    for (; i + 2U <= size; i += 2U)
+    {
+        const auto value{_mm_min_pd(upper, _mm_max_pd(lower, _mm_loadu_pd(x + i)))};
+        const auto square{_mm_mul_pd(value, value)};
+        auto numerator{_mm_set1_pd(Tier::numerator[Tier::numeratorCount - 1U])};
+        auto denominator{_mm_set1_pd(Tier::denominator[3U])};
+
+        for (auto j{Tier::numeratorCount - 1U}; j-- > 0U;)
+        {
+            numerator = _mm_add_pd(_mm_mul_pd(numerator, square), 
+                                   _mm_set1_pd(Tier::numerator[j]));
+        }
+        for (std::size_t j{3U}; j-- > 0U;)
+        {
+            denominator = _mm_add_pd(_mm_mul_pd(denominator, square), 
+                                     _mm_set1_pd(Tier::denominator[j]));
+        }
+        _mm_storeu_pd(y + i, _mm_div_pd(_mm_mul_pd(value, numerator), denominator));
+    }
+    tanhScalar<Tier>(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+template <typename Tier>
+__attribute__((target("sse2")))
+void tanhSse2(const float* x, float* y, const std::size_t size)
+{
+    const auto upper{_mm_set1_ps(static_cast<float>(Tier::clamp))};
+    const auto lower{_mm_set1_ps(static_cast<float>(-Tier::clamp))};
+    std::size_t i{};
+
+    for (; i + 4U <= size; i += 4U)
+    {
+        const auto value{_mm_min_ps(upper, _mm_max_ps(lower, _mm_loadu_ps(x + i)))};
+        const auto square{_mm_mul_ps(value, value)};
+        auto numerator{_mm_set1_ps(static_cast<float>(
+            Tier::numerator[Tier::numeratorCount - 1U]))};
+        auto denominator{_mm_set1_ps(static_cast<float>(Tier::denominator[3U]))};
+
+        for (auto j{Tier::numeratorCount - 1U}; j-- > 0U;)
+        {
+            numerator = _mm_add_ps(_mm_mul_ps(numerator, square), 
+                                   _mm_set1_ps(static_cast<float>(Tier::numerator[j])));
+        }
+        for (std::size_t j{3U}; j-- > 0U;)
+        {
+            denominator = _mm_add_ps(_mm_mul_ps(denominator, square), 
+                                     _mm_set1_ps(static_cast<float>(Tier::denominator[j])));
+        }
+        _mm_storeu_ps(y + i, _mm_div_ps(_mm_mul_ps(value, numerator), denominator));
+    }
+    tanhScalar<Tier>(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+double dotAvx2(const double* x, const double* y, const std::size_t size)
+{
+    auto sum0{_mm256_setzero_pd()};
+    auto sum1{_mm256_setzero_pd()};
+    auto sum2{_mm256_setzero_pd()};
+    auto sum3{_mm256_setzero_pd()};
+    std::size_t i{};
+
+    for (; i + 16U <= size; i += 16U)
+    {
+        sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), sum0);
+        sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4U), _mm256_loadu_pd(y + i + 4U), sum1);
+        sum2 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 8U), _mm256_loadu_pd(y + i + 8U), sum2);
+        sum3 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 12U), _mm256_loadu_pd(y + i + 12U), sum3);
+    }
+    for (; i + 4U <= size; i += 4U)
+    {
+        sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), sum0);
+    }
+    sum0 = _mm256_add_pd(_mm256_add_pd(sum0, sum1), _mm256_add_pd(sum2, sum3));
+    auto low{_mm_add_pd(_mm256_castpd256_pd128(sum0), _mm256_extractf128_pd(sum0, 1))};
+    low = _mm_add_sd(low, _mm_unpackhi_pd(low, low));
+    auto sum{_mm_cvtsd_f64(low)};
+
+    for (; i < size; ++i) { sum += x[i] * y[i]; }
+    return sum;
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+void axpyAvx2(const double alpha, const double* x, double* y, const std::size_t size)
+{
+    const auto scale{_mm256_set1_pd(alpha)};
+    std::size_t i{};
+
+    for (; i + 8U <= size; i += 8U)
+    {
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(scale, _mm256_loadu_pd(x + i),
+                                                _mm256_loadu_pd(y + i)));
+        _mm256_storeu_pd(y + i + 4U, _mm256_fmadd_pd(scale, _mm256_loadu_pd(x + i + 4U),
+                                                     _mm256_loadu_pd(y + i + 4U)));
+    }
+    for (; i + 4U <= size; i += 4U)
+    {
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(scale, _mm256_loadu_pd(x + i),
+                                                _mm256_loadu_pd(y + i)));
+    }
+    for (; i < size; ++i) { y[i] += alpha * x[i]; }
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+void fusedAxpyAvx2(const double alpha, const double beta, const double* x, double* w, 
+                   double* y, const std::size_t size)
+{
+    const auto scaleW{_mm256_set1_pd(alpha)};
+    const auto scaleX{_mm256_set1_pd(beta)};
+    std::size_t i{};
+
+    for (; i + 4U <= size; i += 4U)
+    {
+        const auto weights{_mm256_loadu_pd(w + i)};
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(scaleW, weights, _mm256_loadu_pd(y + i)));
+        _mm256_storeu_pd(w + i, _mm256_fmadd_pd(scaleX, _mm256_loadu_pd(x + i), weights));
+    }
+    fusedAxpyScalar(alpha, beta, x + i, w + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+void axpy4Avx2(const double* alpha, const double* a, const std::size_t stride, double* y, 
+               const std::size_t size)
+{
+    const auto scale0{_mm256_set1_pd(alpha[0U])};
+    const auto scale1{_mm256_set1_pd(alpha[1U])};
+    const auto scale2{_mm256_set1_pd(alpha[2U])};
+    const auto scale3{_mm256_set1_pd(alpha[3U])};
+    std::size_t i{};
+
+    for (; i + 4U <= size; i += 4U)
+    {
+        auto sum{_mm256_loadu_pd(y + i)};
+        sum = _mm256_fmadd_pd(scale0, _mm256_loadu_pd(a + i), sum);
+        sum = _mm256_fmadd_pd(scale1, _mm256_loadu_pd(a + stride + i), sum);
+        sum = _mm256_fmadd_pd(scale2, _mm256_loadu_pd(a + 2U * stride + i), sum);
+        sum = _mm256_fmadd_pd(scale3, _mm256_loadu_pd(a + 3U * stride + i), sum);
+        _mm256_storeu_pd(y + i, sum);
+    }
+    axpy4Scalar(alpha, a + i, stride, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+float dotAvx2(const float* x, const float* y, const std::size_t size)
+{
+    auto sum0{_mm256_setzero_ps()};
+    auto sum1{_mm256_setzero_ps()};
+    auto sum2{_mm256_setzero_ps()};
+    auto sum3{_mm256_setzero_ps()};
+    std::size_t i{};
+
+    for (; i + 32U <= size; i += 32U)
+    {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), sum0);
+        sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8U), _mm256_loadu_ps(y + i + 8U), sum1);
+        sum2 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 16U), _mm256_loadu_ps(y + i + 16U), sum2);
+        sum3 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 24U), _mm256_loadu_ps(y + i + 24U), sum3);
+    }
+    for (; i + 8U <= size; i += 8U)
+    {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), sum0);
+    }
+    sum0 = _mm256_add_ps(_mm256_add_ps(sum0, sum1), _mm256_add_ps(sum2, sum3));
+    alignas(32) float lanes[8U];
+    _mm256_store_ps(lanes, sum0);
+    auto sum{((lanes[0U] + lanes[4U]) + (lanes[1U] + lanes[5U])) + 
+             ((lanes[2U] + lanes[6U]) + (lanes[3U] + lanes[7U]))};
+
+    for (; i < size; ++i) { sum += x[i] * y[i]; }
+    return sum;
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+void axpyAvx2(const float alpha, const float* x, float* y, const std::size_t size)
+{
+    const auto scale{_mm256_set1_ps(alpha)};
+    std::size_t i{};
+
+    for (; i + 16U <= size; i += 16U)
+    {
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(scale, _mm256_loadu_ps(x + i),
+                                                _mm256_loadu_ps(y + i)));
+        _mm256_storeu_ps(y + i + 8U, _mm256_fmadd_ps(scale, _mm256_loadu_ps(x + i + 8U),
+                                                     _mm256_loadu_ps(y + i + 8U)));
+    }
+    for (; i + 8U <= size; i += 8U)
+    {
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(scale, _mm256_loadu_ps(x + i),
+                                                _mm256_loadu_ps(y + i)));
+    }
+    for (; i < size; ++i) { y[i] += alpha * x[i]; }
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+void fusedAxpyAvx2(const float alpha, const float beta, const float* x, float* w, 
+                   float* y, const std::size_t size)
+{
+    const auto scaleW{_mm256_set1_ps(alpha)};
+    const auto scaleX{_mm256_set1_ps(beta)};
+    std::size_t i{};
+
+    for (; i + 8U <= size; i += 8U)
+    {
+        const auto weights{_mm256_loadu_ps(w + i)};
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(scaleW, weights, _mm256_loadu_ps(y + i)));
+        _mm256_storeu_ps(w + i, _mm256_fmadd_ps(scaleX, _mm256_loadu_ps(x + i), weights));
+    }
+    fusedAxpyScalar(alpha, beta, x + i, w + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+void axpy4Avx2(const float* alpha, const float* a, const std::size_t stride, float* y, 
+               const std::size_t size)
+{
+    const auto scale0{_mm256_set1_ps(alpha[0U])};
+    const auto scale1{_mm256_set1_ps(alpha[1U])};
+    const auto scale2{_mm256_set1_ps(alpha[2U])};
+    const auto scale3{_mm256_set1_ps(alpha[3U])};
+    std::size_t i{};
+
+    for (; i + 8U <= size; i += 8U)
+    {
+        auto sum{_mm256_loadu_ps(y + i)};
+        sum = _mm256_fmadd_ps(scale0, _mm256_loadu_ps(a + i), sum);
+        sum = _mm256_fmadd_ps(scale1, _mm256_loadu_ps(a + stride + i), sum);
+        sum = _mm256_fmadd_ps(scale2, _mm256_loadu_ps(a + 2U * stride + i), sum);
+        sum = _mm256_fmadd_ps(scale3, _mm256_loadu_ps(a + 3U * stride + i), sum);
+        _mm256_storeu_ps(y + i, sum);
+    }
+    axpy4Scalar(alpha, a + i, stride, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx2")))
+std::int32_t dotAvx2(const std::int8_t* x, const std::int8_t* y, const std::size_t size)
+{
+    auto sum0{_mm256_setzero_si256()};
+    auto sum1{_mm256_setzero_si256()};
+    std::size_t i{};
+
+    for (; i + 32U <= size; i += 32U)
+    {
+        const auto aLow{_mm256_cvtepi8_epi16(_mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(x + i)))};
+        const auto bLow{_mm256_cvtepi8_epi16(_mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(y + i)))};
+        const auto aHigh{_mm256_cvtepi8_epi16(_mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(x + i + 16U)))};
+        const auto bHigh{_mm256_cvtepi8_epi16(_mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(y + i + 16U)))};
+        sum0 = _mm256_add_epi32(sum0, _mm256_madd_epi16(aLow, bLow));
+        sum1 = _mm256_add_epi32(sum1, _mm256_madd_epi16(aHigh, bHigh));
+    }
+    alignas(32) std::int32_t lanes[8U];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi32(sum0, sum1));
+    std::int32_t result{};
+    for (const auto lane : lanes) { result += lane; }
+
+    for (; i < size; ++i) { result += x[i] * y[i]; }
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx2")))
+void reluAvx2(const double* x, double* y, const std::size_t size)
+{
+    const auto zero{_mm256_setzero_pd()};
+    std::size_t i{};
+
+    for (; i + 4U <= size; i += 4U) 
+    { 
+        _mm256_storeu_pd(y + i, _mm256_max_pd(_mm256_loadu_pd(x + i), zero)); 
+    }
+    reluScalar(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx2")))
+void reluGradientAvx2(const double* x, double* y, const std::size_t size)
+{
+    const auto zero{_mm256_setzero_pd()};
+    std::size_t i{};
+
+    for (; i + 4U <= size; i += 4U)
+    {
+        const auto positive{_mm256_cmp_pd(_mm256_loadu_pd(x + i), zero, _CMP_GT_OQ)};
+        _mm256_storeu_pd(y + i, _mm256_and_pd(positive, _mm256_loadu_pd(y + i)));
+    }
+    reluGradientScalar(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx2")))
+void reluAvx2(const float* x, float* y, const std::size_t size)
+{
+    const auto zero{_mm256_setzero_ps()};
+    std::size_t i{};
+
+    for (; i + 8U <= size; i += 8U) 
+    { 
+        _mm256_storeu_ps(y + i, _mm256_max_ps(_mm256_loadu_ps(x + i), zero)); 
+    }
+    reluScalar(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx2")))
+void reluGradientAvx2(const float* x, float* y, const std::size_t size)
+{
+    const auto zero{_mm256_setzero_ps()};
+    std::size_t i{};
+
+    for (; i + 8U <= size; i += 8U)
+    {
+        const auto positive{_mm256_cmp_ps(_mm256_loadu_ps(x + i), zero, _CMP_GT_OQ)};
+        _mm256_storeu_ps(y + i, _mm256_and_ps(positive, _mm256_loadu_ps(y + i)));
+    }
+    reluGradientScalar(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+void tanhGradientAvx2(const double* x, double* y, const std::size_t size)
+{
+    const auto one{_mm256_set1_pd(1.0)};
+    std::size_t i{};
+
+    for (; i + 4U <= size; i += 4U)
+    {
+        const auto output{_mm256_loadu_pd(x + i)};
+        const auto gradient{_mm256_fnmadd_pd(output, output, one)};
+        _mm256_storeu_pd(y + i, _mm256_mul_pd(_mm256_loadu_pd(y + i), gradient));
+    }
+    tanhGradientScalar(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+void tanhGradientAvx2(const float* x, float* y, const std::size_t size)
+{
+    const auto one{_mm256_set1_ps(1.0f)};
+    std::size_t i{};
+
+    for (; i + 8U <= size; i += 8U)
+    {
+        const auto output{_mm256_loadu_ps(x + i)};
+        const auto gradient{_mm256_fnmadd_ps(output, output, one)};
+        _mm256_storeu_ps(y + i, _mm256_mul_ps(_mm256_loadu_ps(y + i), gradient));
+    }
+    tanhGradientScalar(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+template <typename Tier>
+__attribute__((target("avx2,fma")))
+void tanhAvx2(const double* x, double* y, const std::size_t size)
+{
+    const auto upper{_mm256_set1_pd(Tier::clamp)};
+    const auto lower{_mm256_set1_pd(-Tier::clamp)};
+    std::size_t i{};
+
+    // The bounds are passed as first operands so that NaN propagates through the clamp.
+    for (; i + 4U <= size; i += 4U)
+    {
+        const auto value{_mm256_min_pd(upper, _mm256_max_pd(lower, _mm256_loadu_pd(x + i)))};
+        const auto square{_mm256_mul_pd(value, value)};
+        auto numerator{_mm256_set1_pd(Tier::numerator[Tier::numeratorCount - 1U])};
+        auto denominator{_mm256_set1_pd(Tier::denominator[3U])};
+
+        for (auto j{Tier::numeratorCount - 1U}; j-- > 0U;)
+        {
+            numerator = _mm256_fmadd_pd(numerator, square, _mm256_set1_pd(Tier::numerator[j]));
+        }
+        for (std::size_t j{3U}; j-- > 0U;)
+        {
+            denominator = _mm256_fmadd_pd(denominator, square, 
+                                          _mm256_set1_pd(Tier::denominator[j]));
+        }
+        _mm256_storeu_pd(y + i, _mm256_div_pd(_mm256_mul_pd(value, numerator), denominator));
+    }
+    tanhScalar<Tier>(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+template <typename Tier>
+__attribute__((target("avx2,fma")))
+void tanhAvx2(const float* x, float* y, const std::size_t size)
+{
+    const auto upper{_mm256_set1_ps(static_cast<float>(Tier::clamp))};
+    const auto lower{_mm256_set1_ps(static_cast<float>(-Tier::clamp))};
+    std::size_t i{};
+
+    for (; i + 8U <= size; i += 8U)
+    {
+        const auto value{_mm256_min_ps(upper, _mm256_max_ps(lower, _mm256_loadu_ps(x + i)))};
+        const auto square{_mm256_mul_ps(value, value)};
+        auto numerator{_mm256_set1_ps(static_cast<float>(
+            Tier::numerator[Tier::numeratorCount - 1U]))};
+        auto denominator{_mm256_set1_ps(static_cast<float>(Tier::denominator[3U]))};
+
+        for (auto j{Tier::numeratorCount - 1U}; j-- > 0U;)
+        {
+            numerator = _mm256_fmadd_ps(numerator, square, 
+                                        _mm256_set1_ps(static_cast<float>(Tier::numerator[j])));
+        }
+        for (std::size_t j{3U}; j-- > 0U;)
+        {
+            denominator = _mm256_fmadd_ps(denominator, square, 
+                _mm256_set1_ps(static_cast<float>(Tier::denominator[j])));
+        }
+        _mm256_storeu_ps(y + i, _mm256_div_ps(_mm256_mul_ps(value, numerator), denominator));
+    }
+    tanhScalar<Tier>(x + i, y + i, size - i);
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+double dotAvx512(const double* x, const double* y, const std::size_t size)
+{
+    auto sum0{_mm512_setzero_pd()};
+    auto sum1{_mm512_setzero_pd()};
+    std::size_t i{};
+
+    for (; i + 16U <= size; i += 16U)
+    {
+        sum0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), sum0);
+        sum1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8U), _mm512_loadu_pd(y + i + 8U), sum1);
+    }
+    if (i + 8U <= size)
+    {
+        sum0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), sum0);
+        i += 8U;
+    }
+    if (i < size)
+    {
+        const auto mask{static_cast<__mmask8>((1U << (size - i)) - 1U)};
+        sum1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, x + i),
+                               _mm512_maskz_loadu_pd(mask, y + i), sum1);
+    }
+    alignas(64) double lanes[8U];
+    _mm512_store_pd(lanes, _mm512_add_pd(sum0, sum1));
+    return ((lanes[0U] + lanes[4U]) + (lanes[1U] + lanes[5U])) + 
+           ((lanes[2U] + lanes[6U]) + (lanes[3U] + lanes[7U]));
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+void axpyAvx512(const double alpha, const double* x, double* y, const std::size_t size)
+{
+    const auto scale{_mm512_set1_pd(alpha)};
+    std::size_t i{};
+
+    for (; i + 8U <= size; i += 8U)
+    {
+        _mm512_storeu_pd(y + i, _mm512_fmadd_pd(scale, _mm512_loadu_pd(x + i),
+                                                _mm512_loadu_pd(y + i)));
+    }
+    if (i < size)
+    {
+        const auto mask{static_cast<__mmask8>((1U << (size - i)) - 1U)};
+        _mm512_mask_storeu_pd(y + i, mask,
+                              _mm512_fmadd_pd(scale, _mm512_maskz_loadu_pd(mask, x + i),
+                                              _mm512_maskz_loadu_pd(mask, y + i)));
+    }
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+float dotAvx512(const float* x, const float* y, const std::size_t size)
+{
+    auto sum0{_mm512_setzero_ps()};
+    auto sum1{_mm512_setzero_ps()};
+    std::size_t i{};
+
+    for (; i + 32U <= size; i += 32U)
+    {
+        sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), sum0);
+        sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 16U), _mm512_loadu_ps(y + i + 16U), sum1);
+    }
+    if (i + 16U <= size)
+    {
+        sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), sum0);
+        i += 16U;
+    }
+    if (i < size)
+    {
+        const auto mask{static_cast<__mmask16>((1U << (size - i)) - 1U)};
+        sum1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, x + i),
+                               _mm512_maskz_loadu_ps(mask, y + i), sum1);
+    }
+    alignas(64) float lanes[16U];
+    _mm512_store_ps(lanes, _mm512_add_ps(sum0, sum1));
+    float sum{};
+    for (std::size_t j{}; j < 8U; ++j) { sum += lanes[j] + lanes[j + 8U]; }
+    return sum;
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+void axpyAvx512(const float alpha, const float* x, float* y, const std::size_t size)
+{
+    const auto scale{_mm512_set1_ps(alpha)};
+    std::size_t i{};
+
+    for (; i + 16U <= size; i += 16U)
+    {
+        _mm512_storeu_ps(y + i, _mm512_fmadd_ps(scale, _mm512_loadu_ps(x + i),
+                                                _mm512_loadu_ps(y + i)));
+    }
+    if (i < size)
+    {
+        const auto mask{static_cast<__mmask16>((1U << (size - i)) - 1U)};
+        _mm512_mask_storeu_ps(y + i, mask,
+                              _mm512_fmadd_ps(scale, _mm512_maskz_loadu_ps(mask, x + i),
+                                              _mm512_maskz_loadu_ps(mask, y + i)));
+    }
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+void fusedAxpyAvx512(const double alpha, const double beta, const double* x, double* w, 
+                     double* y, const std::size_t size)
+{
+    const auto scaleW{_mm512_set1_pd(alpha)};
+    const auto scaleX{_mm512_set1_pd(beta)};
+
+    for (std::size_t i{}; i < size; i += 8U)
+    {
+        const auto mask{static_cast<__mmask8>((1U << std::min<std::size_t>(size - i, 8U)) - 1U)};
+        const auto weights{_mm512_maskz_loadu_pd(mask, w + i)};
+        _mm512_mask_storeu_pd(y + i, mask, _mm512_fmadd_pd(scaleW, weights, 
+                                                           _mm512_maskz_loadu_pd(mask, y + i)));
+        _mm512_mask_storeu_pd(w + i, mask, 
+                              _mm512_fmadd_pd(scaleX, _mm512_maskz_loadu_pd(mask, x + i), weights));
+    }
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+void fusedAxpyAvx512(const float alpha, const float beta, const float* x, float* w, 
+                     float* y, const std::size_t size)
+{
+    const auto scaleW{_mm512_set1_ps(alpha)};
+    const auto scaleX{_mm512_set1_ps(beta)};
+
+    for (std::size_t i{}; i < size; i += 16U)
+    {
+        const auto mask{static_cast<__mmask16>((1U << std::min<std::size_t>(size - i, 16U)) - 1U)};
+        const auto weights{_mm512_maskz_loadu_ps(mask, w + i)};
+        _mm512_mask_storeu_ps(y + i, mask, _mm512_fmadd_ps(scaleW, weights, 
+                                                           _mm512_maskz_loadu_ps(mask, y + i)));
+        _mm512_mask_storeu_ps(w + i, mask, 
+                              _mm512_fmadd_ps(scaleX, _mm512_maskz_loadu_ps(mask, x + i), weights));
+    }
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+void axpy4Avx512(const double* alpha, const double* a, const std::size_t stride, double* y, 
+                 const std::size_t size)
+{
+    const auto scale0{_mm512_set1_pd(alpha[0U])};
+    const auto scale1{_mm512_set1_pd(alpha[1U])};
+    const auto scale2{_mm512_set1_pd(alpha[2U])};
+    const auto scale3{_mm512_set1_pd(alpha[3U])};
+
+    for (std::size_t i{}; i < size; i += 8U)
+    {
+        const auto mask{static_cast<__mmask8>((1U << std::min<std::size_t>(size - i, 8U)) - 1U)};
+        auto sum{_mm512_maskz_loadu_pd(mask, y + i)};
+        sum = _mm512_fmadd_pd(scale0, _mm512_maskz_loadu_pd(mask, a + i), sum);
+        sum = _mm512_fmadd_pd(scale1, _mm512_maskz_loadu_pd(mask, a + stride + i), sum);
+        sum = _mm512_fmadd_pd(scale2, _mm512_maskz_loadu_pd(mask, a + 2U * stride + i), sum);
+        sum = _mm512_fmadd_pd(scale3, _mm512_maskz_loadu_pd(mask, a + 3U * stride + i), sum);
+        _mm512_mask_storeu_pd(y + i, mask, sum);
+    }
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+void axpy4Avx512(const float* alpha, const float* a, const std::size_t stride, float* y, 
+                 const std::size_t size)
+{
+    const auto scale0{_mm512_set1_ps(alpha[0U])};
+    const auto scale1{_mm512_set1_ps(alpha[1U])};
+    const auto scale2{_mm512_set1_ps(alpha[2U])};
+    const auto scale3{_mm512_set1_ps(alpha[3U])};
+
+    for (std::size_t i{}; i < size; i += 16U)
+    {
+        const auto mask{static_cast<__mmask16>((1U << std::min<std::size_t>(size - i, 16U)) - 1U)};
+        auto sum{_mm512_maskz_loadu_ps(mask, y + i)};
+        sum = _mm512_fmadd_ps(scale0, _mm512_maskz_loadu_ps(mask, a + i), sum);
+        sum = _mm512_fmadd_ps(scale1, _mm512_maskz_loadu_ps(mask, a + stride + i), sum);
+        sum = _mm512_fmadd_ps(scale2, _mm512_maskz_loadu_ps(mask, a + 2U * stride + i), sum);
+        sum = _mm512_fmadd_ps(scale3, _mm512_maskz_loadu_ps(mask, a + 3U * stride + i), sum);
+        _mm512_mask_storeu_ps(y + i, mask, sum);
+    }
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+void reluAvx512(const double* x, double* y, const std::size_t size)
+{
+    const auto zero{_mm512_setzero_pd()};
+
+    for (std::size_t i{}; i < size; i += 8U)
+    {
+        const auto mask{static_cast<__mmask8>((1U << std::min<std::size_t>(size - i, 8U)) - 1U)};
+        const auto value{_mm512_maskz_loadu_pd(mask, x + i)};
+        _mm512_mask_storeu_pd(y + i, mask, _mm512_maskz_max_pd(mask, value, zero));
+    }
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+void reluGradientAvx512(const double* x, double* y, const std::size_t size)
+{
+    const auto zero{_mm512_setzero_pd()};
+
+    for (std::size_t i{}; i < size; i += 8U)
+    {
+        const auto mask{static_cast<__mmask8>((1U << std::min<std::size_t>(size - i, 8U)) - 1U)};
+        const auto positive{_mm512_mask_cmp_pd_mask(mask, _mm512_maskz_loadu_pd(mask, x + i), 
+                                                    zero, _CMP_GT_OQ)};
+        _mm512_mask_storeu_pd(y + i, mask, _mm512_maskz_loadu_pd(positive, y + i));
+    }
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+void reluAvx512(const float* x, float* y, const std::size_t size)
+{
+    const auto zero{_mm512_setzero_ps()};
+
+    for (std::size_t i{}; i < size; i += 16U)
+    {
+        const auto mask{static_cast<__mmask16>((1U << std::min<std::size_t>(size - i, 16U)) - 1U)};
+        const auto value{_mm512_maskz_loadu_ps(mask, x + i)};
+        _mm512_mask_storeu_ps(y + i, mask, _mm512_maskz_max_ps(mask, value, zero));
+    }
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+void reluGradientAvx512(const float* x, float* y, const std::size_t size)
+{
+    const auto zero{_mm512_setzero_ps()};
+
+    for (std::size_t i{}; i < size; i += 16U)
+    {
+        const auto mask{static_cast<__mmask16>((1U << std::min<std::size_t>(size - i, 16U)) - 1U)};
+        const auto positive{_mm512_mask_cmp_ps_mask(mask, _mm512_maskz_loadu_ps(mask, x + i), 
+                                                    zero, _CMP_GT_OQ)};
+        _mm512_mask_storeu_ps(y + i, mask, _mm512_maskz_loadu_ps(positive, y + i));
+    }
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+void tanhGradientAvx512(const double* x, double* y, const std::size_t size)
+{
+    const auto one{_mm512_set1_pd(1.0)};
+
+    for (std::size_t i{}; i < size; i += 8U)
+    {
+        const auto mask{static_cast<__mmask8>((1U << std::min<std::size_t>(size - i, 8U)) - 1U)};
+        const auto output{_mm512_maskz_loadu_pd(mask, x + i)};
+        const auto gradient{_mm512_fnmadd_pd(output, output, one)};
+        _mm512_mask_storeu_pd(y + i, mask, 
+                              _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, y + i), gradient));
+    }
+}
+
+// -----------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+void tanhGradientAvx512(const float* x, float* y, const std::size_t size)
+{
+    const auto one{_mm512_set1_ps(1.0f)};
+
+    for (std::size_t i{}; i < size; i += 16U)
+    {
+        const auto mask{static_cast<__mmask16>((1U << std::min<std::size_t>(size - i, 16U)) - 1U)};
+        const auto output{_mm512_maskz_loadu_ps(mask, x + i)};
+        const auto gradient{_mm512_fnmadd_ps(output, output, one)};
+        _mm512_mask_storeu_ps(y + i, mask, 
+                              _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, y + i), gradient));
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename Tier>
+__attribute__((target("avx512f")))
+void tanhAvx512(const double* x, double* y, const std::size_t size)
+{
+    const auto upper{_mm512_set1_pd(Tier::clamp)};
+    const auto lower{_mm512_set1_pd(-Tier::clamp)};
+
+    for (std::size_t i{}; i < size; i += 8U)
+    {
+        const auto mask{static_cast<__mmask8>((1U << std::min<std::size_t>(size - i, 8U)) - 1U)};
+        const auto input{_mm512_maskz_loadu_pd(mask, x + i)};
+        const auto value{_mm512_maskz_min_pd(mask, upper, _mm512_maskz_max_pd(mask, lower, input))};
+        const auto square{_mm512_mul_pd(value, value)};
+        auto numerator{_mm512_set1_pd(Tier::numerator[Tier::numeratorCount - 1U])};
+        auto denominator{_mm512_set1_pd(Tier::denominator[3U])};
+
+        for (auto j{Tier::numeratorCount - 1U}; j-- > 0U;)
+        {
+            numerator = _mm512_fmadd_pd(numerator, square, _mm512_set1_pd(Tier::numerator[j]));
+        }
+        for (std::size_t j{3U}; j-- > 0U;)
+        {
+            denominator = _mm512_fmadd_pd(denominator, square, 
+                                          _mm512_set1_pd(Tier::denominator[j]));
+        }
+        _mm512_mask_storeu_pd(y + i, mask, 
+                              _mm512_div_pd(_mm512_mul_pd(value, numerator), denominator));
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename Tier>
+__attribute__((target("avx512f")))
+void tanhAvx512(const float* x, float* y, const std::size_t size)
+{
+    const auto upper{_mm512_set1_ps(static_cast<float>(Tier::clamp))};
+    const auto lower{_mm512_set1_ps(static_cast<float>(-Tier::clamp))};
+
+    for (std::size_t i{}; i < size; i += 16U)
+    {
+        const auto mask{static_cast<__mmask16>((1U << std::min<std::size_t>(size - i, 16U)) - 1U)};
+        const auto input{_mm512_maskz_loadu_ps(mask, x + i)};
+        const auto value{_mm512_maskz_min_ps(mask, upper, _mm512_maskz_max_ps(mask, lower, input))};
+        const auto square{_mm512_mul_ps(value, value)};
+        auto numerator{_mm512_set1_ps(static_cast<float>(
+            Tier::numerator[Tier::numeratorCount - 1U]))};
+        auto denominator{_mm512_set1_ps(static_cast<float>(Tier::denominator[3U]))};
+
+        for (auto j{Tier::numeratorCount - 1U}; j-- > 0U;)
+        {
+            numerator = _mm512_fmadd_ps(numerator, square, 
+                                        _mm512_set1_ps(static_cast<float>(Tier::numerator[j])));
+        }
+        for (std::size_t j{3U}; j-- > 0U;)
+        {
+            denominator = _mm512_fmadd_ps(denominator, square, 
+                _mm512_set1_ps(static_cast<float>(Tier::denominator[j])));
+        }
+        _mm512_mask_storeu_ps(y + i, mask, 
+                              _mm512_div_ps(_mm512_mul_ps(value, numerator), denominator));
+    }
+}
+
+// -----------------------------------------------------------------------------
+ml::InstructionSet detectInstructionSet()
+{
+    unsigned eax{}, ebx{}, ecx{}, edx{};
+    if (!__get_cpuid(1U, &eax, &ebx, &ecx, &edx)) { return ml::InstructionSet::Scalar; }
+
+    const auto sse2{(edx & bit_SSE2) != 0U};
+    const auto fma{(ecx & bit_FMA) != 0U};
+    const auto avx{(ecx & bit_AVX) != 0U};
+    const auto osxsave{(ecx & bit_OSXSAVE) != 0U};
+    if (!sse2) { return ml::InstructionSet::Scalar; }
+    if (!avx || !osxsave || !fma) { return ml::InstructionSet::Sse2; }
+
+    // Checks that the operating system saves the vector registers on context switches.
+    unsigned xcr0Low{}, xcr0High{};
+    __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0U));
+    if ((xcr0Low & 0x06U) != 0x06U) { return ml::InstructionSet::Sse2; }
+
+    if (!__get_cpuid_count(7U, 0U, &eax, &ebx, &ecx, &edx)) { return ml::InstructionSet::Sse2; }
+    const auto avx2{(ebx & bit_AVX2) != 0U};
+    const auto avx512f{(ebx & bit_AVX512F) != 0U};
+    if (!avx2) { return ml::InstructionSet::Sse2; }
+    if (avx512f && ((xcr0Low & 0xE6U) == 0xE6U)) { return ml::InstructionSet::Avx512; }
+    return ml::InstructionSet::Avx2;
+}
+
+#else
+
+// -----------------------------------------------------------------------------
+ml::InstructionSet detectInstructionSet() { return ml::InstructionSet::Scalar; }
+
+#endif /* ML_KERNELS_X86 */
+
+// -----------------------------------------------------------------------------
+KernelTable kernelTable(const ml::InstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+#ifdef ML_KERNELS_X86
+        case ml::InstructionSet::Avx512:
+            // Byte and word arithmetic requires AVX-512BW, hence AVX2 is used for int8.
+            return KernelTable{dotAvx512, axpyAvx512, dotAvx512, axpyAvx512, dotAvx2, 
+                               fusedAxpyAvx512, fusedAxpyAvx512,
+                               transposedProduct<double, axpy4Avx512, axpyAvx512>,
+                               transposedProduct<float, axpy4Avx512, axpyAvx512>,
+                               reluAvx512, reluGradientAvx512, reluAvx512, reluGradientAvx512,
+                               tanhGradientAvx512, tanhGradientAvx512,
+                               tanhAvx512<TanhHigh>, tanhAvx512<TanhLow>, 
+                               tanhAvx512<TanhHigh>, tanhAvx512<TanhLow>};
+        case ml::InstructionSet::Avx2:
+            return KernelTable{dotAvx2, axpyAvx2, dotAvx2, axpyAvx2, dotAvx2, 
+                               fusedAxpyAvx2, fusedAxpyAvx2,
+                               transposedProduct<double, axpy4Avx2, axpyAvx2>,
+                               transposedProduct<float, axpy4Avx2, axpyAvx2>,
+                               reluAvx2, reluGradientAvx2, reluAvx2, reluGradientAvx2,
+                               tanhGradientAvx2, tanhGradientAvx2,
+                               tanhAvx2<TanhHigh>, tanhAvx2<TanhLow>, 
+                               tanhAvx2<TanhHigh>, tanhAvx2<TanhLow>};
+        case ml::InstructionSet::Sse2:
+            return KernelTable{dotSse2, axpySse2, dotSse2, axpySse2, dotSse2,
+                               fusedAxpySse2, fusedAxpySse2,
+                               transposedProduct<double, axpy4Sse2, axpySse2>,
+                               transposedProduct<float, axpy4Sse2, axpySse2>,
+                               reluSse2, reluGradientSse2, reluSse2, reluGradientSse2,
+                               tanhGradientSse2, tanhGradientSse2,
+                               tanhSse2<TanhHigh>, tanhSse2<TanhLow>, 
+                               tanhSse2<TanhHigh>, tanhSse2<TanhLow>};
+#endif /* ML_KERNELS_X86 */
+        default:
+            return KernelTable{dotScalar, axpyScalar, dotScalar, axpyScalar, dotScalar,
+                               fusedAxpyScalar<double>, fusedAxpyScalar<float>,
+                               transposedProduct<double, axpy4Scalar, axpyScalar>,
+                               transposedProduct<float, axpy4Scalar, axpyScalar>,
+                               reluScalar<double>, reluGradientScalar<double>, 
+                               reluScalar<float>, reluGradientScalar<float>,
+                               tanhGradientScalar<double>, tanhGradientScalar<float>,
+                               tanhScalar<TanhHigh, double>, tanhScalar<TanhLow, double>,
+                               tanhScalar<TanhHigh, float>, tanhScalar<TanhLow, float>};
+    }
+}
+
+/*******************************************************************************
+ * @brief Structure holding the selected instruction set and its kernels.
+ ******************************************************************************/
+struct Dispatcher
+{
+    ml::InstructionSet supported; // The most capable supported instruction set.
+    ml::InstructionSet selected;  // The instruction set currently in use.
+    KernelTable kernels;          // The kernels of the selected instruction set.
+};
+
+// -----------------------------------------------------------------------------
+Dispatcher& dispatcher()
+{
+    static Dispatcher instance{[]()
+    {
+        const auto supported{detectInstructionSet()};
+        return Dispatcher{supported, supported, kernelTable(supported)};
+    }()};
+    return instance;
+}
+
+} // namespace
+
+namespace ml
+{
+namespace kernels
+{
+
+// -----------------------------------------------------------------------------
+InstructionSet supportedInstructionSet() { return dispatcher().supported; }
+
+// -----------------------------------------------------------------------------
+InstructionSet instructionSet() { return dispatcher().selected; }
+
+// -----------------------------------------------------------------------------
+void selectInstructionSet(const InstructionSet instructionSet)
+{
+    if (instructionSet >= InstructionSet::Count)
+    {
+        throw std::invalid_argument("Invalid instruction set!");
+    }
+    if (instructionSet > supportedInstructionSet())
+    {
+        throw std::invalid_argument("The instruction set is not supported by the CPU!");
+    }
+    dispatcher().selected = instructionSet;
+    dispatcher().kernels  = kernelTable(instructionSet);
+}
+
+// -----------------------------------------------------------------------------
+const char* instructionSetName(const InstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+        case InstructionSet::Scalar:
+            return "Scalar";
+        case InstructionSet::Sse2:
+            return "SSE2";
+        case InstructionSet::Avx2:
+            return "AVX2";
+        case InstructionSet::Avx512:
+            return "AVX-512";
+        default:
+            throw std::invalid_argument("Invalid instruction set!");
+    }
+}
+
+// -----------------------------------------------------------------------------
+double dot(const double* x, const double* y, const std::size_t size)
+{
+    return dispatcher().kernels.dot(x, y, size);
+}
+
+// -----------------------------------------------------------------------------
+void axpy(const double alpha, const double* x, double* y, const std::size_t size)
+{
+    dispatcher().kernels.axpy(alpha, x, y, size);
+}
+
+// -----------------------------------------------------------------------------
+float dot(const float* x, const float* y, const std::size_t size)
+{
+    return dispatcher().kernels.dotFloat(x, y, size);
+}
+
+// -----------------------------------------------------------------------------
+void axpy(const float alpha, const float* x, float* y, const std::size_t size)
+{
+    dispatcher().kernels.axpyFloat(alpha, x, y, size);
+}
+
+// -----------------------------------------------------------------------------
+void transposedProduct(const double* x, const double* a, const std::size_t rowCount, 
+                       const std::size_t stride, double* y, const std::size_t size)
+{
+    dispatcher().kernels.transposedProduct(x, a, rowCount, stride, y, size);
+}
+
+// -----------------------------------------------------------------------------
+void transposedProduct(const float* x, const float* a, const std::size_t rowCount, 
+                       const std::size_t stride, float* y, const std::size_t size)
+{
+    dispatcher().kernels.transposedProductFloat(x, a, rowCount, stride, y, size);
+}
+
+// -----------------------------------------------------------------------------
+void fusedAxpy(const double alpha, const double beta, const double* x, double* w, 
+               double* y, const std::size_t size)
+{
+    dispatcher().kernels.fusedAxpy(alpha, beta, x, w, y, size);
+}
+
+// -----------------------------------------------------------------------------
+void fusedAxpy(const float alpha, const float beta, const float* x, float* w, 
+               float* y, const std::size_t size)
+{
+    dispatcher().kernels.fusedAxpyFloat(alpha, beta, x, w, y, size);
+}
+
+// -----------------------------------------------------------------------------
+std::int32_t dot(const std::int8_t* x, const std::int8_t* y, const std::size_t size)
+{
+    return dispatcher().kernels.dotInt8(x, y, size);
+}
+
+// -----------------------------------------------------------------------------
+void relu(const double* x, double* y, const std::size_t size)
+{
+    dispatcher().kernels.relu(x, y, size);
+}
+
+// -----------------------------------------------------------------------------
+void relu(const float* x, float* y, const std::size_t size)
+{
+    dispatcher().kernels.reluFloat(x, y, size);
+}
+
+// -----------------------------------------------------------------------------
+void reluGradient(const double* x, double* y, const std::size_t size)
+{
+    dispatcher().kernels.reluGradient(x, y, size);
+}
+
+// -----------------------------------------------------------------------------
+void reluGradient(const float* x, float* y, const std::size_t size)
+{
+    dispatcher().kernels.reluGradientFloat(x, y, size);
+}
+
+// -----------------------------------------------------------------------------
+void tanhGradient(const double* x, double* y, const std::size_t size)
+{
+    dispatcher().kernels.tanhGradient(x, y, size);
+}
+
+// -----------------------------------------------------------------------------
+void tanhGradient(const float* x, float* y, const std::size_t size)
+{
+    dispatcher().kernels.tanhGradientFloat(x, y, size);
+}
+
+// -----------------------------------------------------------------------------
+void tanh(const double* x, double* y, const std::size_t size, const TanhPrecision precision)
+{
+    switch (precision)
+    {
+        case TanhPrecision::Exact:
+            tanhExact(x, y, size);
+            break;
+        case TanhPrecision::High:
+            dispatcher().kernels.tanhHigh(x, y, size);
+            break;
+        case TanhPrecision::Low:
+            dispatcher().kernels.tanhLow(x, y, size);
+            break;
+        default:
+            throw std::invalid_argument("Invalid tanh precision!");
+    }
+}
+
+// -----------------------------------------------------------------------------
+void tanh(const float* x, float* y, const std::size_t size, const TanhPrecision precision)
+{
+    switch (precision)
+    {
+        case TanhPrecision::Exact:
+            tanhExact(x, y, size);
+            break;
+        case TanhPrecision::High:
+            dispatcher().kernels.tanhHighFloat(x, y, size);
+            break;
+        case TanhPrecision::Low:
+            dispatcher().kernels.tanhLowFloat(x, y, size);
+            break;
+        default:
+            throw std::invalid_argument("Invalid tanh precision!");
+    }
+}
+
+} // namespace kernels
+} // namespace ml
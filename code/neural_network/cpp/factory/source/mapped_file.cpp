@@ -0,0 +1,54 @@
+/*******************************************************************************
+ * @brief Implementation details of files mapped into memory.
+ ******************************************************************************/
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mapped_file.h"
+
+namespace ml
+{
+
+// -----------------------------------------------------------------------------
+MappedFile mapFile(const std::string& path, const std::size_t minimumSize)
+{
+    const int descriptor{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (descriptor < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "Failed to open " + path);
+    }
+    struct stat status{};
+    if (::fstat(descriptor, &status) < 0)
+    {
+        const auto error{errno};
+        ::close(descriptor);
+        throw std::system_error(error, std::generic_category(), "Failed to stat " + path);
+    }
+    const auto size{static_cast<std::size_t>(status.st_size)};
+    if ((size == 0U) || (size < minimumSize))
+    {
+        ::close(descriptor);
+        throw std::invalid_argument("File " + path + " is too small!");
+    }
+    auto* const address{::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                               descriptor, 0)};
+    const auto error{errno};
+    ::close(descriptor);
+    if (address == MAP_FAILED)
+    {
+        throw std::system_error(error, std::generic_category(), "Failed to map " + path);
+    }
+    const std::shared_ptr<const void> storage{address, [size](const void* mapping)
+    {
+        ::munmap(const_cast<void*>(mapping), size);
+    }};
+    return MappedFile{storage, static_cast<char*>(address), size};
+}
+
+} // namespace ml
@@ -0,0 +1,254 @@
+/*******************************************************************************
+ * @brief Implementation details of the binary model format.
+ ******************************************************************************/
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "dense_layer.h"
+#include "mapped_file.h"
+#include "matrix.h"
+#include "model_format.h"
+#include "neural_network.h"
+
+namespace
+{
+
+/*******************************************************************************
+ * @brief The number of layer records of a model file.
+ ******************************************************************************/
+constexpr std::size_t LayerCount{2U};
+
+/*******************************************************************************
+ * @brief Class computing standard 64-bit FNV-1a checksums, processing the
+ *        data one byte at a time. The checksum of data processed in several
+ *        updates equals the checksum of the same data processed at once.
+ ******************************************************************************/
+class Checksum
+{
+public:
+
+    // -----------------------------------------------------------------------------
+    void update(const void* data, const std::size_t size) noexcept
+    {
+        const auto* bytes{static_cast<const unsigned char*>(data)};
+
+        for (std::size_t i{}; i < size; ++i)
+        {
+            myValue = (myValue ^ bytes[i]) * 0x100000001B3ULL;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    std::uint64_t value() const noexcept { return myValue; }
+
+private:
+
+    std::uint64_t myValue{0xCBF29CE484222325ULL}; // The current checksum.
+};
+
+// -----------------------------------------------------------------------------
+constexpr std::size_t alignSection(const std::size_t offset) noexcept
+{
+    constexpr auto alignment{ml::model::SectionAlignment};
+    return (offset + alignment - 1U) / alignment * alignment;
+}
+
+// -----------------------------------------------------------------------------
+void checkModel(const bool valid, const char* message)
+{
+    if (!valid) { throw std::invalid_argument(std::string{"Invalid model file: "} + message); }
+}
+
+// -----------------------------------------------------------------------------
+void checkSection(const std::uint64_t offset, const std::uint64_t count,
+                  const std::size_t elementSize, const std::uint64_t fileSize)
+{
+    checkModel((offset % ml::model::SectionAlignment) == 0U, "misaligned section!");
+    checkModel((offset <= fileSize) && (count <= (fileSize - offset) / elementSize),
+               "section exceeds the file!");
+}
+
+// -----------------------------------------------------------------------------
+ml::model::ModelHeader readHeader(const ml::MappedFile& file)
+{
+    ml::model::ModelHeader header{};
+    std::memcpy(&header, file.data, sizeof(header));
+    checkModel(std::equal(std::begin(ml::model::Magic), std::end(ml::model::Magic), 
+                          header.magic), "unknown signature!");
+    checkModel(header.version == ml::model::Version, "unsupported version!");
+    checkModel(header.layerCount == LayerCount, "unsupported layer count!");
+    checkModel(header.fileSize == file.size, "truncated file!");
+    return header;
+}
+
+// -----------------------------------------------------------------------------
+void checkChecksum(const ml::MappedFile& file, const ml::model::ModelHeader& header)
+{
+    Checksum checksum{};
+    checksum.update(file.data + sizeof(header), file.size - sizeof(header));
+    checkModel(checksum.value() == header.checksum, "checksum mismatch!");
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void writeSection(std::ofstream& file, Checksum& checksum, const T* data,
+                  const std::size_t count)
+{
+    // The last partial block is padded before it is written, and the padding is
+    // checksummed as well, since verification covers every byte of the file.
+    const auto* const bytes{reinterpret_cast<const char*>(data)};
+    const auto size{count * sizeof(T)};
+    const auto blockSize{size / ml::model::SectionAlignment * ml::model::SectionAlignment};
+    std::array<char, ml::model::SectionAlignment> lastBlock{};
+    std::copy(bytes + blockSize, bytes + size, lastBlock.begin());
+
+    file.write(bytes, static_cast<std::streamsize>(blockSize));
+    checksum.update(bytes, blockSize);
+
+    if (blockSize < size)
+    {
+        file.write(lastBlock.data(), static_cast<std::streamsize>(lastBlock.size()));
+        checksum.update(lastBlock.data(), lastBlock.size());
+    }
+}
+
+} // namespace
+
+namespace ml
+{
+namespace model
+{
+
+static_assert(SectionAlignment == Matrix<double>::Alignment,
+    "Sections must be aligned like the rows of a matrix!");
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void save(const NeuralNetworkInterface<T>& network, const std::string& path)
+{
+    const std::array<const DenseLayerInterface<T>*, LayerCount> layers{
+        &network.hiddenLayer(), &network.outputLayer()};
+    std::array<LayerRecord, LayerCount> records{};
+    auto offset{alignSection(sizeof(ModelHeader) + sizeof(records))};
+
+    for (std::size_t i{}; i < LayerCount; ++i)
+    {
+        const auto& weights{(*layers[i]).weights()};
+        records[i].nodeCount     = weights.rowCount();
+        records[i].weightCount   = weights.columnCount();
+        records[i].stride        = weights.stride();
+        records[i].biasOffset    = offset;
+        records[i].weightOffset  = alignSection(offset + weights.rowCount() * sizeof(T));
+        records[i].actFunc       = (*layers[i]).actFunc();
+        records[i].tanhPrecision = (*layers[i]).tanhPrecision();
+        offset = alignSection(records[i].weightOffset +
+                              weights.rowCount() * weights.stride() * sizeof(T));
+    }
+
+    // The file is written next to the target and renamed once complete, so that
+    // an existing model is never replaced by a partially written one.
+    const auto temporaryPath{path + ".tmp"};
+    std::ofstream file{temporaryPath, std::ios::binary | std::ios::trunc};
+    if (!file)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to create " + temporaryPath);
+    }
+    ModelHeader header{};
+    std::copy(std::begin(Magic), std::end(Magic), header.magic);
+    header.version    = Version;
+    header.scalarType = scalarType<T>();
+    header.layerCount = static_cast<std::uint32_t>(LayerCount);
+    header.fileSize   = offset;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    Checksum checksum{};
+    writeSection(file, checksum, records.data(), records.size());
+
+    for (std::size_t i{}; i < LayerCount; ++i)
+    {
+        const auto& weights{(*layers[i]).weights()};
+        writeSection(file, checksum, (*layers[i]).bias().data(), weights.rowCount());
+        writeSection(file, checksum, weights.data(), weights.rowCount() * weights.stride());
+    }
+    header.checksum = checksum.value();
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+
+    if (!file || (std::rename(temporaryPath.c_str(), path.c_str()) != 0))
+    {
+        const auto error{errno};
+        std::remove(temporaryPath.c_str());
+        throw std::system_error(error, std::generic_category(), "Failed to write " + path);
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::unique_ptr<NeuralNetworkInterface<T>> load(const std::string& path,
+                                                const bool verifyChecksum)
+{
+    // Training the loaded network copies the modified pages of the private 
+    // mapping instead of writing them back to the file.
+    const auto file{mapFile(path, sizeof(ModelHeader))};
+    const auto fileSize{file.size};
+    auto* const bytes{file.data};
+
+    const auto header{readHeader(file)};
+    checkModel(header.scalarType == scalarType<T>(), "mismatching scalar type!");
+    checkSection(sizeof(ModelHeader), LayerCount, sizeof(LayerRecord), fileSize);
+    if (verifyChecksum) { checkChecksum(file, header); }
+    std::array<LayerRecord, LayerCount> records{};
+    std::memcpy(records.data(), bytes + sizeof(header), sizeof(records));
+    std::array<std::unique_ptr<DenseLayerInterface<T>>, LayerCount> layers{};
+
+    for (std::size_t i{}; i < LayerCount; ++i)
+    {
+        const auto& record{records[i]};
+        checkModel((record.nodeCount > 0U) && (record.weightCount > 0U), "empty layer!");
+        checkModel(record.weightCount <= Matrix<T>::MaxColumnCount, "too many weights per node!");
+        const auto stride{Matrix<T>::strideFor(record.weightCount)};
+        checkModel((stride != 0U) && (record.stride == stride), "unsupported weight stride!");
+        checkModel(record.actFunc < ActFunc::Count, "unknown activation function!");
+        checkModel(record.tanhPrecision < TanhPrecision::Count, "unknown tanh precision!");
+        checkSection(record.biasOffset, record.nodeCount, sizeof(T), fileSize);
+        checkModel(record.nodeCount <= fileSize / record.stride, "section exceeds the file!");
+        checkSection(record.weightOffset, record.nodeCount * record.stride, sizeof(T), fileSize);
+
+        const auto* const bias{reinterpret_cast<const T*>(bytes + record.biasOffset)};
+        auto* const weights{reinterpret_cast<T*>(bytes + record.weightOffset)};
+        layers[i] = std::make_unique<DenseLayer<T>>(
+            std::vector<T>(bias, bias + record.nodeCount),
+            Matrix<T>{weights, record.nodeCount, record.weightCount},
+            record.actFunc, record.tanhPrecision);
+    }
+    return std::make_unique<NeuralNetwork<T>>(std::move(layers[0U]), std::move(layers[1U]),
+                                              file.storage);
+}
+
+// -----------------------------------------------------------------------------
+void verify(const std::string& path)
+{
+    const auto file{mapFile(path, sizeof(ModelHeader))};
+    checkChecksum(file, readHeader(file));
+}
+
+template void save<float>(const NeuralNetworkInterface<float>&, const std::string&);
+template std::unique_ptr<NeuralNetworkInterface<float>> load<float>(const std::string&,
+                                                                    const bool);
+
+template void save<double>(const NeuralNetworkInterface<double>&, const std::string&);
+template std::unique_ptr<NeuralNetworkInterface<double>> load<double>(const std::string&,
+                                                                      const bool);
+
+} // namespace model
+} // namespace ml
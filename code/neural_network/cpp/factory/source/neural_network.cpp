@@ -1,20 +1,35 @@
 /*******************************************************************************
  * @brief Implementation details of the ml::NeuralNetwork class.
  ******************************************************************************/
+#include <algorithm>
+#include <exception>
 #include <iomanip>
 #include <stdexcept>
+#include <utility>
 
 #include "dense_layer.h"
 #include "factory.h"
+#include "kernels.h"
 #include "neural_network.h"
+#include "thread_pool.h"
 #include "utils.h"
 
 namespace
 {
 
+/*******************************************************************************
+ * @brief The number of training sets predicted per batch when measuring the 
+ *        accuracy over a streamed dataset or the stored training sets.
+ ******************************************************************************/
+constexpr std::size_t EvaluationBatchSize{256U};
+
 // -----------------------------------------------------------------------------
-void checkTrainingSets(const std::vector<std::vector<double>>& trainingInput,
-                       const std::vector<std::vector<double>>& trainingOutput)
+std::size_t poolThreadCount() { return utils::ThreadPool::instance().threadCount(); }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void checkTrainingSets(const std::vector<std::vector<T>>& trainingInput,
+                       const std::vector<std::vector<T>>& trainingOutput)
 {
     if (trainingInput.size() != trainingOutput.size())
     {
@@ -26,6 +41,16 @@ void checkTrainingSets(const std::vector<std::vector<double>>& trainingInput,
     }
 }
 
+// -----------------------------------------------------------------------------
+template <typename T>
+void checkTrainingSetsAdded(const ml::TrainingData<T>& trainingData)
+{
+    if (trainingData.empty())
+    {
+        throw(std::invalid_argument("Training sets missing!"));
+    }
+}
+
 // -----------------------------------------------------------------------------
 void checkTrainingParameters(const std::size_t epochCount, const double learningRate)
 {
@@ -40,12 +65,102 @@ void checkTrainingParameters(const std::size_t epochCount, const double learning
 }
 
 // -----------------------------------------------------------------------------
-void checkVectorsMatching(const std::vector<double>& vec1, const std::vector<double>& vec2)
+void checkBatchSize(const std::size_t batchSize)
+{
+    if (batchSize == 0U)
+    {
+        throw(std::invalid_argument("Invalid batch size 0!"));
+    }
+}
+
+// -----------------------------------------------------------------------------
+void checkThreadCount(const std::size_t threadCount)
+{
+    if (threadCount == 0U)
+    {
+        throw(std::invalid_argument("Invalid thread count 0!"));
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void checkDatasetShape(const ml::StreamingDataset<T>& dataset, 
+                       const ml::NeuralNetworkInterface<T>& network)
+{
+    if ((dataset.inputCount() != network.inputCount()) || 
+        (dataset.outputCount() != network.outputCount()))
+    {
+        throw(std::invalid_argument("Dataset does not match the shape of the neural network!"));
+    }
+}
+
+// -----------------------------------------------------------------------------
+void checkTrainStrategy(const ml::TrainStrategy strategy)
+{
+    if (strategy >= ml::TrainStrategy::Count)
+    {
+        throw(std::invalid_argument("Invalid training strategy!"));
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename Task>
+void parallelFor(const std::size_t taskCount, const Task& task)
+{
+    utils::ThreadPool::instance().parallelFor(0U, taskCount, 1U, 
+        [&task](const std::size_t first, const std::size_t last)
+    {
+        for (auto i{first}; i < last; ++i) { task(i); }
+    });
+}
+
+// -----------------------------------------------------------------------------
+constexpr std::size_t shardStart(const std::size_t size, const std::size_t shardCount, 
+                                 const std::size_t shard)
+{
+    return size * shard / shardCount;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void addGradients(const std::vector<T>& biasGradient, 
+                  const ml::Matrix<T>& weightGradient,
+                  std::vector<T>& biasGradientSum, 
+                  ml::Matrix<T>& weightGradientSum,
+                  const std::size_t firstRow, const std::size_t lastRow)
+{
+    for (std::size_t i{firstRow}; i < lastRow; ++i)
+    {
+        biasGradientSum[i] += biasGradient[i];
+        ml::kernels::axpy(T{1}, weightGradient.row(i).data(), weightGradientSum.row(i).data(), 
+                          weightGradientSum.columnCount());
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename Prediction, typename Reference>
+double absoluteError(const Prediction& prediction, const Reference& reference)
 {
-    if (vec1.size() != vec2.size())
+    double sum{};
+
+    for (std::size_t i{}; i < prediction.size(); ++i)
     {
-        throw(std::invalid_argument("Mismatching vectors!"));
+        sum += utils::math::absoluteValue(reference[i] - prediction[i]);
     }
+    return sum;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double absoluteError(const ml::Matrix<T>& prediction, const ml::Matrix<T>& reference)
+{
+    double sum{};
+
+    for (std::size_t i{}; i < prediction.rowCount(); ++i)
+    {
+        sum += absoluteError(prediction.row(i), reference.row(i));
+    }
+    return sum;
 }
 } // namespace
 
@@ -53,120 +168,357 @@ namespace ml
 {
 
 // -----------------------------------------------------------------------------
-NeuralNetwork::NeuralNetwork(const std::size_t inputCount, 
-                             const std::size_t hiddenNodesCount,
-                             const std::size_t outputCount, 
-                             const ActFunc actFuncHidden, 
-                             const ActFunc actFuncOutput)
-    : myHiddenLayer{factory::denseLayer(hiddenNodesCount, inputCount, actFuncHidden)} 
-    , myOutputLayer{factory::denseLayer(outputCount, hiddenNodesCount, actFuncOutput)}
+template <typename T>
+NeuralNetwork<T>::NeuralNetwork(const std::size_t inputCount, 
+                                const std::size_t hiddenNodesCount,
+                                const std::size_t outputCount, 
+                                const ActFunc actFuncHidden, 
+                                const ActFunc actFuncOutput,
+                                const TanhPrecision tanhPrecision)
+    : myStorage{}
+    , myHiddenLayer{factory::denseLayer<T>(hiddenNodesCount, inputCount, actFuncHidden, 
+                                           tanhPrecision)} 
+    , myOutputLayer{factory::denseLayer<T>(outputCount, hiddenNodesCount, actFuncOutput, 
+                                           tanhPrecision)}
     , myTrainingOrder{}
-    , myTrainingInput{nullptr}
-    , myTrainingOutput{nullptr} {}
+    , myTrainingData{}
+    , myTrainingSetInput{}
+    , myTrainingSetOutput{}
+    , myBatchBuffers(1U)
+    , myInferenceContext{}
+    , myHiddenError(hiddenNodesCount)
+    , myExactEvaluation{false}
+    , myWeightsVersion{}
+    , myPredictions{}
+    , myEvaluationOutput{}
+    , myPredictionsVersion{}
+    , myPredictionsCached{false} {}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+NeuralNetwork<T>::NeuralNetwork(std::unique_ptr<DenseLayerInterface<T>> hiddenLayer,
+                                std::unique_ptr<DenseLayerInterface<T>> outputLayer,
+                                std::shared_ptr<const void> storage)
+    : myStorage{std::move(storage)}
+    , myHiddenLayer{std::move(hiddenLayer)}
+    , myOutputLayer{std::move(outputLayer)}
+    , myTrainingOrder{}
+    , myTrainingData{}
+    , myTrainingSetInput{}
+    , myTrainingSetOutput{}
+    , myBatchBuffers(1U)
+    , myInferenceContext{}
+    , myHiddenError{}
+    , myExactEvaluation{false}
+    , myWeightsVersion{}
+    , myPredictions{}
+    , myEvaluationOutput{}
+    , myPredictionsVersion{}
+    , myPredictionsCached{false}
+{
+    if ((myHiddenLayer == nullptr) || (myOutputLayer == nullptr))
+    {
+        throw(std::invalid_argument("Cannot create neural network without layers!"));
+    }
+    if ((*myOutputLayer).weightCount() != (*myHiddenLayer).nodeCount())
+    {
+        throw(std::invalid_argument("Mismatching hidden and output layer!"));
+    }
+    myHiddenError.resize((*myHiddenLayer).nodeCount());
+}
 
 // -----------------------------------------------------------------------------
-std::size_t NeuralNetwork::inputCount() const 
+template <typename T>
+std::size_t NeuralNetwork<T>::inputCount() const 
 { 
     return (*myHiddenLayer).weightCount(); 
 }
 
 // -----------------------------------------------------------------------------
-std::size_t NeuralNetwork::hiddenNodesCount() const
+template <typename T>
+std::size_t NeuralNetwork<T>::hiddenNodesCount() const
 {
     return (*myHiddenLayer).nodeCount();
 }
 
 // -----------------------------------------------------------------------------
-std::size_t NeuralNetwork::outputCount() const
+template <typename T>
+std::size_t NeuralNetwork<T>::outputCount() const
 {
     return (*myOutputLayer).nodeCount();
 }
 
 // -----------------------------------------------------------------------------
-const std::vector<double>& NeuralNetwork::output() const
+template <typename T>
+const DenseLayerInterface<T>& NeuralNetwork<T>::hiddenLayer() const
+{
+    return *myHiddenLayer;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+const DenseLayerInterface<T>& NeuralNetwork<T>::outputLayer() const
+{
+    return *myOutputLayer;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+const std::vector<T>& NeuralNetwork<T>::output() const
 {
     return (*myOutputLayer).output();
 }
 
 // -----------------------------------------------------------------------------
-std::size_t NeuralNetwork::trainingSetCount() const
+template <typename T>
+std::size_t NeuralNetwork<T>::trainingSetCount() const
 {
     return myTrainingOrder.size();
 }
 
 // -----------------------------------------------------------------------------
-const std::vector<double>& NeuralNetwork::predict(const std::vector<double>& input)
+template <typename T>
+const Matrix<T>& NeuralNetwork<T>::trainingInput() const
+{
+    checkTrainingSetsAdded(myTrainingData);
+    return myTrainingData.input();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+const Matrix<T>& NeuralNetwork<T>::trainingOutput() const
 {
-    feedforward(input);
+    checkTrainingSetsAdded(myTrainingData);
+    return myTrainingData.reference();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t NeuralNetwork<T>::weightsVersion() const { return myWeightsVersion; }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+const std::vector<T>& NeuralNetwork<T>::predict(const std::vector<T>& input)
+{
+    (*myHiddenLayer).feedforward(input);
+    (*myOutputLayer).feedforward((*myHiddenLayer).output());
     return output();
 }
 
 // -----------------------------------------------------------------------------
-void NeuralNetwork::addTrainingSets(const std::vector<std::vector<double>>& trainingInput,
-                                    const std::vector<std::vector<double>>& trainingOutput)
+template <typename T>
+void NeuralNetwork<T>::predict(const Matrix<T>& input, Matrix<T>& output)
+{
+    predict(input, output, myInferenceContext);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+const std::vector<T>& NeuralNetwork<T>::predict(const std::vector<T>& input,
+                                                InferenceContext<T>& context) const
+{
+    (*myHiddenLayer).feedforward(input, context.hiddenOutput);
+    (*myOutputLayer).feedforward(context.hiddenOutput, context.output);
+    return context.output;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void NeuralNetwork<T>::predict(const Matrix<T>& input, Matrix<T>& output, 
+                               InferenceContext<T>& context) const
+{
+    (*myHiddenLayer).feedforward(input, context.hiddenBatchOutput);
+    (*myOutputLayer).feedforward(context.hiddenBatchOutput, output);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void NeuralNetwork<T>::setGradientCaching(const bool enable)
+{
+    (*myHiddenLayer).setGradientCaching(enable);
+    (*myOutputLayer).setGradientCaching(enable);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void NeuralNetwork<T>::setExactEvaluation(const bool enable) { myExactEvaluation = enable; }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void NeuralNetwork<T>::addTrainingSets(const std::vector<std::vector<T>>& trainingInput,
+                                       const std::vector<std::vector<T>>& trainingOutput)
 {
     checkTrainingSets(trainingInput, trainingOutput);
-    myTrainingInput  = &trainingInput;
-    myTrainingOutput = &trainingOutput;
+    addTrainingSets(TrainingData<T>{trainingInput, trainingOutput});
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void NeuralNetwork<T>::addTrainingSets(TrainingData<T>&& trainingData)
+{
+    checkTrainingSetsAdded(trainingData);
+    if ((trainingData.inputCount() != inputCount()) || 
+        (trainingData.outputCount() != outputCount()))
+    {
+        throw(std::invalid_argument("Training sets do not match the shape of the network!"));
+    }
+    myTrainingData      = std::move(trainingData);
+    myPredictionsCached = false;
     initTrainingOrder();
 }
 
 // -----------------------------------------------------------------------------
-double NeuralNetwork::train(const std::size_t epochCount, const double learningRate)
+template <typename T>
+double NeuralNetwork<T>::train(const std::size_t epochCount, const T learningRate)
 {
     checkTrainingParameters(epochCount, learningRate);
+    double errorSum{};
 
     for (std::size_t epoch{}; epoch < epochCount; ++epoch)
     {
         randomizeTrainingOrder();
+        errorSum = 0.0;
 
         for (const auto& i : myTrainingOrder)
         {
-            feedforward((*myTrainingInput)[i]);
-            backpropagate((*myTrainingOutput)[i]);
-            optimize((*myTrainingInput)[i], learningRate);
+            loadTrainingSet(i);
+            feedforward(myTrainingSetInput);
+            errorSum += absoluteError(output(), myTrainingSetOutput);
+            backpropagateAndOptimize(myTrainingSetInput, myTrainingSetOutput, learningRate);
+        }
+    }
+    return epochAccuracy(errorSum);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double NeuralNetwork<T>::train(const std::size_t epochCount, const T learningRate, 
+                               const std::size_t batchSize, const std::size_t threadCount,
+                               const TrainStrategy strategy)
+{
+    checkTrainingParameters(epochCount, learningRate);
+    checkBatchSize(batchSize);
+    checkThreadCount(threadCount);
+    checkTrainStrategy(strategy);
+    if (myBatchBuffers.size() < threadCount) { myBatchBuffers.resize(threadCount); }
+
+    for (std::size_t epoch{}; epoch < epochCount; ++epoch)
+    {
+        randomizeTrainingOrder();
+        for (auto& buffers : myBatchBuffers) { buffers.errorSum = 0.0; }
+
+        if (strategy == TrainStrategy::Asynchronous) 
+        { 
+            trainAsynchronous(learningRate, batchSize, threadCount); 
         }
+        else { trainSynchronous(learningRate, batchSize, threadCount); }
     }
-    return accuracy();
+    double errorSum{};
+    for (const auto& buffers : myBatchBuffers) { errorSum += buffers.errorSum; }
+    return epochAccuracy(errorSum);
 }
 
 // -----------------------------------------------------------------------------
-double NeuralNetwork::accuracy()
+template <typename T>
+double NeuralNetwork<T>::train(StreamingDataset<T>& dataset, const std::size_t epochCount, 
+                               const T learningRate, const std::size_t batchSize)
+{
+    checkTrainingParameters(epochCount, learningRate);
+    checkBatchSize(batchSize);
+    checkDatasetShape(dataset, *this);
+    auto& buffers{myBatchBuffers[0U]};
+    std::size_t count{};
+
+    for (std::size_t epoch{}; epoch < epochCount; ++epoch)
+    {
+        dataset.rewind();
+        buffers.errorSum = 0.0;
+        count            = 0U;
+
+        while (dataset.read(buffers.input, buffers.reference, batchSize) > 0U)
+        {
+            computeGradients(buffers);
+            optimize(buffers, learningRate / buffers.input.rowCount());
+            count += buffers.input.rowCount();
+        }
+    }
+    if (myExactEvaluation) { return accuracy(dataset); }
+    return count > 0U ? 1.0 - buffers.errorSum / inputCount() / count : 0.0;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double NeuralNetwork<T>::accuracy()
 {
     if (trainingSetCount() == 0U) { return 0.0; }
+    const auto sum{absoluteError(trainingPredictions(), myTrainingData.reference())};
+    return 1.0 - sum / inputCount() / trainingSetCount();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double NeuralNetwork<T>::accuracy(StreamingDataset<T>& dataset)
+{
+    checkDatasetShape(dataset, *this);
+    Matrix<T> input{};
+    Matrix<T> reference{};
     double sum{};
+    std::size_t count{};
+    dataset.rewind();
 
-    for (std::size_t i{}; i < trainingSetCount(); ++i)
+    // Enough training sets are read at a time to give each thread one batch.
+    while (dataset.read(input, reference, EvaluationBatchSize * poolThreadCount()) > 0U)
+    {
+        sum   += predictInParallel(input, reference, myEvaluationOutput);
+        count += input.rowCount();
+    }
+    dataset.rewind();
+    return count > 0U ? 1.0 - sum / inputCount() / count : 0.0;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double NeuralNetwork<T>::evaluate(const TrainingData<T>& data)
+{
+    if (data.empty()) { return 0.0; }
+    if ((data.inputCount() != inputCount()) || (data.outputCount() != outputCount()))
     {
-        sum += averageError((*myTrainingInput)[i], (*myTrainingOutput)[i]);
+        throw(std::invalid_argument("Data sets do not match the shape of the network!"));
     }
-    return 1.0 - sum / trainingSetCount();
+    const auto sum{predictInParallel(data.input(), data.reference(), myEvaluationOutput)};
+    return 1.0 - sum / inputCount() / data.size();
 }
 
 // -----------------------------------------------------------------------------
-void NeuralNetwork::printResults(std::ostream& ostream, const std::size_t decimalCount)
+template <typename T>
+void NeuralNetwork<T>::printResults(std::ostream& ostream, const std::size_t decimalCount)
 {
     ostream << std::fixed << std::setprecision(decimalCount);
     ostream << "--------------------------------------------------------------------------------\n";
     ostream << "Prediction accuracy: " << accuracy() * 100 << "%\n";
+    const auto& predictions{trainingPredictions()};
 
     for (std::size_t i{}; i < trainingSetCount(); ++i)
     {
+        const auto input{myTrainingData.input().row(i)};
+        const auto prediction{predictions.row(i)};
+        const auto reference{myTrainingData.reference().row(i)};
         ostream << "Input: "; 
-        utils::vector::print((*myTrainingInput)[i], ostream, ", ", decimalCount);
+        utils::vector::print(input.data(), input.size(), ostream, ", ", decimalCount);
         ostream << "prediction: ";
-        utils::vector::print(predict((*myTrainingInput)[i]), ostream, ", ", decimalCount);
+        utils::vector::print(prediction.data(), prediction.size(), ostream, ", ", decimalCount);
         ostream << "reference: ";
-        utils::vector::print((*myTrainingOutput)[i], ostream, ", ", decimalCount);
-        ostream << "error: " << averageError((*myTrainingInput)[i], (*myTrainingOutput)[i]) << "\n";
+        utils::vector::print(reference.data(), reference.size(), ostream, ", ", decimalCount);
+        ostream << "error: " << averageError(i) << "\n";
     }
     ostream << "--------------------------------------------------------------------------------\n\n";
 }
 
 // -----------------------------------------------------------------------------
-void NeuralNetwork::initTrainingOrder()
+template <typename T>
+void NeuralNetwork<T>::initTrainingOrder()
 {
-    myTrainingOrder.resize(myTrainingInput->size());
+    myTrainingOrder.resize(myTrainingData.size());
 
     for (std::size_t i{}; i < myTrainingOrder.size(); ++i) 
     { 
@@ -175,45 +527,250 @@ void NeuralNetwork::initTrainingOrder()
 }
 
 // -----------------------------------------------------------------------------
-void NeuralNetwork::randomizeTrainingOrder()
+template <typename T>
+void NeuralNetwork<T>::loadTrainingSet(const std::size_t index)
+{
+    const auto input{myTrainingData.input().row(index)};
+    const auto reference{myTrainingData.reference().row(index)};
+    myTrainingSetInput.assign(input.begin(), input.end());
+    myTrainingSetOutput.assign(reference.begin(), reference.end());
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void NeuralNetwork<T>::randomizeTrainingOrder()
 {
     utils::vector::shuffle(myTrainingOrder);
 }
 
 // -----------------------------------------------------------------------------
-void NeuralNetwork::feedforward(const std::vector<double>& input)
+template <typename T>
+void NeuralNetwork<T>::feedforward(const std::vector<T>& input)
 {
-    (*myHiddenLayer).feedforward(input);
-    (*myOutputLayer).feedforward((*myHiddenLayer).output());
+    (*myHiddenLayer).feedforwardForTraining(input);
+    (*myOutputLayer).feedforwardForTraining((*myHiddenLayer).output());
 }
 
 // -----------------------------------------------------------------------------
-void NeuralNetwork::backpropagate(const std::vector<double>& reference)
+template <typename T>
+void NeuralNetwork<T>::backpropagateAndOptimize(const std::vector<T>& input, 
+                                                const std::vector<T>& reference, 
+                                                const T learningRate)
 {
     (*myOutputLayer).backpropagate(reference);
-    (*myHiddenLayer).backpropagate(*myOutputLayer);
+    (*myOutputLayer).optimize((*myHiddenLayer).output(), learningRate, myHiddenError);
+    (*myHiddenLayer).backpropagateError(myHiddenError);
+    (*myHiddenLayer).optimize(input, learningRate);
+    ++myWeightsVersion;
 }
 
 // -----------------------------------------------------------------------------
-void NeuralNetwork::optimize(const std::vector<double>& input, const double learningRate)
+template <typename T>
+void NeuralNetwork<T>::trainSynchronous(const T learningRate, const std::size_t batchSize, 
+                                        const std::size_t threadCount)
 {
-    (*myHiddenLayer).optimize(input, learningRate);
-    (*myOutputLayer).optimize((*myHiddenLayer).output(), learningRate);
+    for (std::size_t first{}; first < trainingSetCount(); first += batchSize)
+    {
+        const auto count{std::min(batchSize, trainingSetCount() - first)};
+
+        if (threadCount == 1U)
+        {
+            loadBatch(myBatchBuffers[0U], first, count);
+            computeGradients(myBatchBuffers[0U]);
+        }
+        else
+        {
+            parallelFor(threadCount, [&](const std::size_t worker)
+            {
+                const auto start{shardStart(count, threadCount, worker)};
+                const auto end{shardStart(count, threadCount, worker + 1U)};
+                loadBatch(myBatchBuffers[worker], first + start, end - start);
+                computeGradients(myBatchBuffers[worker]);
+            });
+            reduceGradients(threadCount);
+        }
+        optimize(myBatchBuffers[0U], learningRate / count);
+    }
 }
 
 // -----------------------------------------------------------------------------
-double NeuralNetwork::averageError(const std::vector<double>& input, 
-                                   const std::vector<double>& reference)
+template <typename T>
+void NeuralNetwork<T>::trainAsynchronous(const T learningRate, const std::size_t batchSize, 
+                                         const std::size_t threadCount)
 {
-    double sum{};
-    const auto prediction{predict(input)};
-    checkVectorsMatching(reference, prediction);
+    // Each worker reads and updates the shared parameters without locks. A worker may
+    // therefore compute gradients from parameters partially updated by other workers,
+    // and concurrent updates of the same parameter may be lost, which is tolerated.
+    parallelFor(threadCount, [&](const std::size_t worker)
+    {
+        auto& buffers{myBatchBuffers[worker]};
+        const auto end{shardStart(trainingSetCount(), threadCount, worker + 1U)};
 
-    for (std::size_t i{}; i < prediction.size(); ++i)
+        for (auto first{shardStart(trainingSetCount(), threadCount, worker)}; 
+             first < end; first += batchSize)
+        {
+            const auto count{std::min(batchSize, end - first)};
+            loadBatch(buffers, first, count);
+            computeGradients(buffers);
+            optimize(buffers, learningRate / count);
+        }
+    });
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double NeuralNetwork<T>::epochAccuracy(const double errorSum)
+{
+    if (trainingSetCount() == 0U) { return 0.0; }
+    if (myExactEvaluation) { return accuracy(); }
+    return 1.0 - errorSum / inputCount() / trainingSetCount();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void NeuralNetwork<T>::loadBatch(BatchBuffers& buffers, const std::size_t first, 
+                                 const std::size_t count) const
+{
+    buffers.input.resize(count, inputCount());
+    buffers.reference.resize(count, outputCount());
+
+    for (std::size_t k{}; k < count; ++k)
     {
-        sum += utils::math::absoluteValue(reference[i] - prediction[i]);
+        const auto i{myTrainingOrder[first + k]};
+        const auto input{myTrainingData.input().row(i)};
+        const auto reference{myTrainingData.reference().row(i)};
+        std::copy(input.begin(), input.end(), buffers.input.row(k).begin());
+        std::copy(reference.begin(), reference.end(), buffers.reference.row(k).begin());
     }
-    return sum / input.size();
 }
 
+// -----------------------------------------------------------------------------
+template <typename T>
+void NeuralNetwork<T>::computeGradients(BatchBuffers& buffers) const
+{
+    (*myHiddenLayer).feedforward(buffers.input, buffers.hiddenOutput);
+    (*myOutputLayer).feedforward(buffers.hiddenOutput, buffers.output);
+    buffers.errorSum += absoluteError(buffers.output, buffers.reference);
+    (*myOutputLayer).backpropagate(buffers.output, buffers.reference, buffers.outputError);
+    (*myHiddenLayer).backpropagate(buffers.hiddenOutput, *myOutputLayer, 
+                                   buffers.outputError, buffers.hiddenError);
+
+    buffers.hiddenBiasGradient.assign(hiddenNodesCount(), T{});
+    buffers.hiddenWeightGradient.resize(hiddenNodesCount(), inputCount());
+    buffers.outputBiasGradient.assign(outputCount(), T{});
+    buffers.outputWeightGradient.resize(outputCount(), hiddenNodesCount());
+
+    (*myHiddenLayer).accumulateGradients(buffers.input, buffers.hiddenError, 
+                                         buffers.hiddenBiasGradient, 
+                                         buffers.hiddenWeightGradient);
+    (*myOutputLayer).accumulateGradients(buffers.hiddenOutput, buffers.outputError,
+                                         buffers.outputBiasGradient, 
+                                         buffers.outputWeightGradient);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void NeuralNetwork<T>::reduceGradients(const std::size_t workerCount)
+{
+    auto& total{myBatchBuffers[0U]};
+
+    parallelFor(workerCount, [&](const std::size_t thread)
+    {
+        for (std::size_t worker{1U}; worker < workerCount; ++worker)
+        {
+            const auto& partial{myBatchBuffers[worker]};
+            addGradients(partial.hiddenBiasGradient, partial.hiddenWeightGradient,
+                         total.hiddenBiasGradient, total.hiddenWeightGradient,
+                         shardStart(hiddenNodesCount(), workerCount, thread),
+                         shardStart(hiddenNodesCount(), workerCount, thread + 1U));
+            addGradients(partial.outputBiasGradient, partial.outputWeightGradient,
+                         total.outputBiasGradient, total.outputWeightGradient,
+                         shardStart(outputCount(), workerCount, thread),
+                         shardStart(outputCount(), workerCount, thread + 1U));
+        }
+    });
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void NeuralNetwork<T>::optimize(const BatchBuffers& buffers, const T learningRate)
+{
+    (*myHiddenLayer).optimize(buffers.hiddenBiasGradient, buffers.hiddenWeightGradient, 
+                              learningRate);
+    (*myOutputLayer).optimize(buffers.outputBiasGradient, buffers.outputWeightGradient, 
+                              learningRate);
+    ++myWeightsVersion;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double NeuralNetwork<T>::predictInParallel(const Matrix<T>& input, const Matrix<T>& reference,
+                                           Matrix<T>& predictions)
+{
+    const auto rowCount{input.rowCount()};
+    const auto batchCount{(rowCount + EvaluationBatchSize - 1U) / EvaluationBatchSize};
+    const auto threadCount{std::max<std::size_t>(
+        std::min(poolThreadCount(), batchCount), 1U)};
+    std::vector<double> errorSums(threadCount);
+    predictions.resize(rowCount, outputCount());
+    if (myBatchBuffers.size() < threadCount) { myBatchBuffers.resize(threadCount); }
+
+    // Each thread predicts whole batches, so the predictions do not depend on the 
+    // thread count. The error sums are reduced in thread order.
+    parallelFor(threadCount, [&](const std::size_t worker)
+    {
+        auto& buffers{myBatchBuffers[worker]};
+
+        for (auto batch{shardStart(batchCount, threadCount, worker)}; 
+             batch < shardStart(batchCount, threadCount, worker + 1U); ++batch)
+        {
+            const auto first{batch * EvaluationBatchSize};
+            const auto count{std::min(EvaluationBatchSize, rowCount - first)};
+            buffers.input.resize(count, inputCount());
+
+            for (std::size_t k{}; k < count; ++k)
+            {
+                const auto row{input.row(first + k)};
+                std::copy(row.begin(), row.end(), buffers.input.row(k).begin());
+            }
+            (*myHiddenLayer).feedforward(buffers.input, buffers.hiddenOutput);
+            (*myOutputLayer).feedforward(buffers.hiddenOutput, buffers.output);
+
+            for (std::size_t k{}; k < count; ++k)
+            {
+                const auto prediction{buffers.output.row(k)};
+                errorSums[worker] += absoluteError(prediction, reference.row(first + k));
+                std::copy(prediction.begin(), prediction.end(), 
+                          predictions.row(first + k).begin());
+            }
+        }
+    });
+    double sum{};
+    for (const auto& errorSum : errorSums) { sum += errorSum; }
+    return sum;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+const Matrix<T>& NeuralNetwork<T>::trainingPredictions()
+{
+    const std::size_t version{myWeightsVersion};
+    if (myPredictionsCached && (myPredictionsVersion == version)) { return myPredictions; }
+    predictInParallel(myTrainingData.input(), myTrainingData.reference(), myPredictions);
+    myPredictionsVersion = version;
+    myPredictionsCached  = true;
+    return myPredictions;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double NeuralNetwork<T>::averageError(const std::size_t index)
+{
+    const auto prediction{trainingPredictions().row(index)};
+    return absoluteError(prediction, myTrainingData.reference().row(index)) / inputCount();
+}
+
+template class NeuralNetwork<float>;
+template class NeuralNetwork<double>;
+
 } // namespace ml
\ No newline at end of file
@@ -0,0 +1,267 @@
+/*******************************************************************************
+ * @brief Implementation details of the ml::QuantizedNetwork class.
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <stdexcept>
+
+#include "factory.h"
+#include "kernels.h"
+#include "quantized_network.h"
+#include "utils.h"
+
+namespace
+{
+
+/*******************************************************************************
+ * @brief The largest magnitude of a quantized value. The range is kept
+ *        symmetric [-127, 127] so that negation never overflows.
+ ******************************************************************************/
+constexpr std::int32_t QuantizedMax{127};
+
+// -----------------------------------------------------------------------------
+template <typename T>
+T quantizationScale(const T* data, const std::size_t size)
+{
+    T maxMagnitude{};
+    for (std::size_t i{}; i < size; ++i)
+    {
+        maxMagnitude = std::max(maxMagnitude, std::abs(data[i]));
+    }
+    return maxMagnitude > 0 ? maxMagnitude / QuantizedMax : T{1};
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void quantizeValues(const T* data, const std::size_t size, const T scale,
+                    std::int8_t* quantized)
+{
+    for (std::size_t i{}; i < size; ++i)
+    {
+        const auto value{static_cast<std::int32_t>(std::lround(data[i] / scale))};
+        quantized[i] = static_cast<std::int8_t>(std::clamp(value, -QuantizedMax, QuantizedMax));
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void checkDataSets(const std::vector<std::vector<T>>& input,
+                   const std::vector<std::vector<T>>& output)
+{
+    if (input.size() != output.size())
+    {
+        throw std::invalid_argument("Mismatching data sets!");
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void checkDataSets(const ml::Matrix<T>& input, const ml::Matrix<T>& output)
+{
+    if (input.rowCount() != output.rowCount())
+    {
+        throw std::invalid_argument("Mismatching data sets!");
+    }
+}
+
+} // namespace
+
+namespace ml
+{
+
+// -----------------------------------------------------------------------------
+template <typename T>
+QuantizedNetwork<T>::QuantizedNetwork(const NeuralNetworkInterface<T>& network)
+    : myHiddenLayer{}
+    , myOutputLayer{}
+    , myLayerInput{}
+{
+    quantize(network.hiddenLayer(), myHiddenLayer);
+    quantize(network.outputLayer(), myOutputLayer);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t QuantizedNetwork<T>::inputCount() const
+{
+    return myHiddenLayer.weights.columnCount();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t QuantizedNetwork<T>::hiddenNodesCount() const
+{
+    return myHiddenLayer.weights.rowCount();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t QuantizedNetwork<T>::outputCount() const
+{
+    return myOutputLayer.weights.rowCount();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+const std::vector<T>& QuantizedNetwork<T>::output() const { return myOutputLayer.output; }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t QuantizedNetwork<T>::parameterSize() const
+{
+    std::size_t size{};
+
+    for (const auto* layer : {&myHiddenLayer, &myOutputLayer})
+    {
+        size += (*layer).weights.rowCount() * (*layer).weights.columnCount();
+        size += ((*layer).weightScale.size() + (*layer).bias.size()) * sizeof(T);
+    }
+    return size;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+const std::vector<T>& QuantizedNetwork<T>::predict(const std::vector<T>& input)
+{
+    if (input.size() != inputCount())
+    {
+        throw std::invalid_argument(
+            "Prediction input does not match the shape of the quantized network!");
+    }
+    feedforward(myHiddenLayer, input);
+    feedforward(myOutputLayer, myHiddenLayer.output);
+    return output();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double QuantizedNetwork<T>::accuracy(const std::vector<std::vector<T>>& input,
+                                     const std::vector<std::vector<T>>& output)
+{
+    checkDataSets(input, output);
+    if (input.empty()) { return 0.0; }
+    double sum{};
+
+    for (std::size_t i{}; i < input.size(); ++i)
+    {
+        sum += averageError(input[i], output[i]);
+    }
+    return 1.0 - sum / input.size();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double QuantizedNetwork<T>::accuracy(const Matrix<T>& input, const Matrix<T>& output)
+{
+    checkDataSets(input, output);
+    if (input.rowCount() == 0U) { return 0.0; }
+    double sum{};
+
+    for (std::size_t i{}; i < input.rowCount(); ++i)
+    {
+        sum += averageError(input.row(i).toVector(), output.row(i).toVector());
+    }
+    return 1.0 - sum / input.rowCount();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double QuantizedNetwork<T>::accuracyDelta(NeuralNetworkInterface<T>& network)
+{
+    return accuracy(network.trainingInput(), network.trainingOutput()) - network.accuracy();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void QuantizedNetwork<T>::printResults(NeuralNetworkInterface<T>& network,
+                                       std::ostream& ostream,
+                                       const std::size_t decimalCount)
+{
+    const auto& trainingInput{network.trainingInput()};
+    const auto& trainingOutput{network.trainingOutput()};
+    const auto referenceAccuracy{network.accuracy()};
+    const auto quantizedAccuracy{accuracy(trainingInput, trainingOutput)};
+
+    ostream << std::fixed << std::setprecision(decimalCount);
+    ostream << "--------------------------------------------------------------------------------\n";
+    ostream << "Prediction accuracy: " << quantizedAccuracy * 100 << "% (reference: "
+            << referenceAccuracy * 100 << "%, delta: "
+            << (quantizedAccuracy - referenceAccuracy) * 100 << "%)\n";
+
+    for (std::size_t i{}; i < trainingInput.rowCount(); ++i)
+    {
+        const auto input{trainingInput.row(i).toVector()};
+        const auto reference{trainingOutput.row(i).toVector()};
+        ostream << "Input: ";
+        utils::vector::print(input, ostream, ", ", decimalCount);
+        ostream << "prediction: ";
+        utils::vector::print(predict(input), ostream, ", ", decimalCount);
+        ostream << "reference: ";
+        utils::vector::print(reference, ostream, ", ", decimalCount);
+        ostream << "error: " << averageError(input, reference) << "\n";
+    }
+    ostream << "--------------------------------------------------------------------------------\n\n";
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void QuantizedNetwork<T>::quantize(const DenseLayerInterface<T>& layer,
+                                   QuantizedLayer& quantized)
+{
+    const auto& weights{layer.weights()};
+    quantized.weights.resize(layer.nodeCount(), layer.weightCount());
+    quantized.weightScale.resize(layer.nodeCount());
+    quantized.bias = layer.bias();
+    quantized.output.assign(layer.nodeCount(), T{});
+    quantized.actFuncCalc = factory::actFuncCalc<T>(layer.actFunc(), layer.tanhPrecision());
+
+    for (std::size_t i{}; i < layer.nodeCount(); ++i)
+    {
+        const auto* row{weights.row(i).data()};
+        quantized.weightScale[i] = quantizationScale(row, layer.weightCount());
+        quantizeValues(row, layer.weightCount(), quantized.weightScale[i],
+                       quantized.weights.row(i).data());
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void QuantizedNetwork<T>::feedforward(QuantizedLayer& layer, const std::vector<T>& input)
+{
+    const auto inputScale{quantizationScale(input.data(), input.size())};
+    myLayerInput.resize(input.size());
+    quantizeValues(input.data(), input.size(), inputScale, myLayerInput.data());
+
+    for (std::size_t i{}; i < layer.output.size(); ++i)
+    {
+        const auto sum{kernels::dot(myLayerInput.data(), layer.weights.row(i).data(),
+                                    input.size())};
+        const auto value{layer.bias[i] + static_cast<T>(sum) * inputScale * layer.weightScale[i]};
+        layer.output[i] = (*layer.actFuncCalc).output(value);
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+double QuantizedNetwork<T>::averageError(const std::vector<T>& input,
+                                         const std::vector<T>& reference)
+{
+    if (reference.size() != outputCount())
+    {
+        throw std::invalid_argument("Mismatching vectors!");
+    }
+    const auto& prediction{predict(input)};
+    double sum{};
+
+    for (std::size_t i{}; i < prediction.size(); ++i)
+    {
+        sum += utils::math::absoluteValue(reference[i] - prediction[i]);
+    }
+    return sum / input.size();
+}
+
+template class QuantizedNetwork<float>;
+template class QuantizedNetwork<double>;
+
+} // namespace ml
@@ -0,0 +1,159 @@
+/*******************************************************************************
+ * @brief Implementation details of the utils::RandomGenerator class.
+ ******************************************************************************/
+#include <atomic>
+#include <mutex>
+#include <random>
+
+#include "random_generator.h"
+
+namespace
+{
+
+/*******************************************************************************
+ * @brief Structure holding the seed shared by the generators of all threads.
+ ******************************************************************************/
+struct SeedState
+{
+    std::mutex mutex;                      // Protects the seed and stream count.
+    std::uint64_t seed;                    // The current seed.
+    std::uint64_t streamCount;             // The number of assigned streams.
+    std::atomic<std::uint64_t> generation; // Incremented when the seed is changed.
+};
+
+/*******************************************************************************
+ * @brief The generator of the calling thread.
+ ******************************************************************************/
+thread_local utils::RandomGenerator threadGenerator{0U};
+
+/*******************************************************************************
+ * @brief The seed generation of the generator of the calling thread (0 = none).
+ ******************************************************************************/
+thread_local std::uint64_t threadGeneration{};
+
+// -----------------------------------------------------------------------------
+SeedState& seedState()
+{
+    static SeedState state{{}, (static_cast<std::uint64_t>(std::random_device{}()) << 32U) ^
+                                std::random_device{}(), 0U, {1U}};
+    return state;
+}
+
+// -----------------------------------------------------------------------------
+constexpr std::uint64_t rotateLeft(const std::uint64_t value, const unsigned bitCount) noexcept
+{
+    return (value << bitCount) | (value >> (64U - bitCount));
+}
+
+// -----------------------------------------------------------------------------
+utils::RandomGenerator streamGenerator(const std::uint64_t seed, const std::uint64_t stream)
+{
+    utils::RandomGenerator generator{seed};
+    for (std::uint64_t i{}; i < stream; ++i) { generator.jump(); }
+    return generator;
+}
+
+} // namespace
+
+namespace utils
+{
+
+// -----------------------------------------------------------------------------
+RandomGenerator::RandomGenerator(const std::uint64_t seed) noexcept
+    : myState{}
+{
+    auto value{seed};
+
+    for (auto& word : myState)
+    {
+        value += 0x9E3779B97F4A7C15ULL;
+        auto z{value};
+        z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+        word = z ^ (z >> 31U);
+    }
+}
+
+// -----------------------------------------------------------------------------
+RandomGenerator& RandomGenerator::local()
+{
+    auto& state{seedState()};
+
+    if (threadGeneration != state.generation.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock{state.mutex};
+        threadGenerator  = streamGenerator(state.seed, state.streamCount++);
+        threadGeneration = state.generation.load(std::memory_order_relaxed);
+    }
+    return threadGenerator;
+}
+
+// -----------------------------------------------------------------------------
+void RandomGenerator::seed(const std::uint64_t seed)
+{
+    auto& state{seedState()};
+    std::lock_guard<std::mutex> lock{state.mutex};
+    state.seed        = seed;
+    state.streamCount = 1U;
+    threadGenerator   = streamGenerator(seed, 0U);
+    threadGeneration  = state.generation.fetch_add(1U, std::memory_order_release) + 1U;
+}
+
+// -----------------------------------------------------------------------------
+RandomGenerator::result_type RandomGenerator::operator()() noexcept
+{
+    const auto result{rotateLeft(myState[1U] * 5U, 7U) * 9U};
+    const auto shifted{myState[1U] << 17U};
+    myState[2U] ^= myState[0U];
+    myState[3U] ^= myState[1U];
+    myState[1U] ^= myState[2U];
+    myState[0U] ^= myState[3U];
+    myState[2U] ^= shifted;
+    myState[3U] = rotateLeft(myState[3U], 45U);
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+std::uint64_t RandomGenerator::bounded(const std::uint64_t bound) noexcept
+{
+    // The high word of number * bound is in [0, bound). Products whose low word
+    // falls below 2^64 mod bound are rejected, which removes the bias.
+    auto product{static_cast<unsigned __int128>((*this)()) * bound};
+    auto low{static_cast<std::uint64_t>(product)};
+
+    if (low < bound)
+    {
+        const auto threshold{(0U - bound) % bound};
+
+        while (low < threshold)
+        {
+            product = static_cast<unsigned __int128>((*this)()) * bound;
+            low     = static_cast<std::uint64_t>(product);
+        }
+    }
+    return static_cast<std::uint64_t>(product >> 64U);
+}
+
+// -----------------------------------------------------------------------------
+void RandomGenerator::jump() noexcept
+{
+    constexpr std::array<std::uint64_t, 4U> polynomial{
+        0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+        0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+    std::array<std::uint64_t, 4U> state{};
+
+    for (const auto& word : polynomial)
+    {
+        for (unsigned bit{}; bit < 64U; ++bit)
+        {
+            if (word & (1ULL << bit))
+            {
+                for (std::size_t i{}; i < state.size(); ++i) { state[i] ^= myState[i]; }
+            }
+            (*this)();
+        }
+    }
+    myState = state;
+}
+
+} // namespace utils
@@ -0,0 +1,352 @@
+/*******************************************************************************
+ * @brief Implementation details of the ml::StreamingDataset class.
+ ******************************************************************************/
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "streaming_dataset.h"
+#include "utils.h"
+
+namespace
+{
+
+// -----------------------------------------------------------------------------
+template <typename T>
+T parseNumber(const char* text, char** end)
+{
+    if constexpr (std::is_same<T, float>::value) { return std::strtof(text, end); }
+    else { return static_cast<T>(std::strtod(text, end)); }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+bool parseCsvLine(const std::string& line, std::vector<T>& values)
+{
+    const char* position{line.c_str()};
+
+    for (std::size_t i{}; i < values.size(); ++i)
+    {
+        char* end{};
+        values[i] = parseNumber<T>(position, &end);
+        if (end == position) { return false; }
+        position = end;
+        while ((*position == ' ') || (*position == '\t') || (*position == '\r')) { ++position; }
+        if (i + 1U < values.size())
+        {
+            if (*position != ',') { return false; }
+            ++position;
+        }
+    }
+    return *position == '\0';
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void keepRows(ml::Matrix<T>& matrix, const std::size_t rowCount)
+{
+    ml::Matrix<T> rows{rowCount, matrix.columnCount()};
+    std::copy(matrix.data(), matrix.data() + rowCount * matrix.stride(), rows.data());
+    matrix = std::move(rows);
+}
+
+} // namespace
+
+namespace ml
+{
+
+// -----------------------------------------------------------------------------
+template <typename T>
+StreamingDataset<T>::StreamingDataset(const std::string& path, const std::size_t inputCount,
+                                      const std::size_t outputCount,
+                                      const DatasetFormat format,
+                                      const std::size_t chunkSize,
+                                      const std::size_t shuffleWindow)
+    : myPath{path}
+    , myInputCount{inputCount}
+    , myOutputCount{outputCount}
+    , myFormat{format}
+    , myChunkSize{chunkSize}
+    , myChunks{}
+    , myReader{}
+    , myMutex{}
+    , myCondition{}
+    , myStopping{false}
+    , myError{}
+    , myChunkIndex{}
+    , myChunkRow{}
+    , myHoldingChunk{false}
+    , myEndOfPass{false}
+    , myPassStarted{false}
+    , myWindowInput{}
+    , myWindowReference{}
+    , myWindowCount{}
+{
+    if ((inputCount == 0U) || (outputCount == 0U))
+    {
+        throw std::invalid_argument("Cannot stream training sets without input or output!");
+    }
+    if (format >= DatasetFormat::Count)
+    {
+        throw std::invalid_argument("Invalid dataset format!");
+    }
+    if (chunkSize == 0U)
+    {
+        throw std::invalid_argument("Invalid chunk size 0!");
+    }
+    if (shuffleWindow == 0U)
+    {
+        throw std::invalid_argument("Invalid shuffle window 0!");
+    }
+    if (!std::ifstream{path})
+    {
+        throw std::system_error(errno, std::generic_category(), "Failed to open " + path);
+    }
+    for (auto& chunk : myChunks)
+    {
+        chunk.input.resize(chunkSize, inputCount);
+        chunk.reference.resize(chunkSize, outputCount);
+    }
+    myWindowInput.resize(shuffleWindow, inputCount);
+    myWindowReference.resize(shuffleWindow, outputCount);
+    startReader();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+StreamingDataset<T>::~StreamingDataset() { stopReader(); }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t StreamingDataset<T>::inputCount() const noexcept { return myInputCount; }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t StreamingDataset<T>::outputCount() const noexcept { return myOutputCount; }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t StreamingDataset<T>::read(Matrix<T>& input, Matrix<T>& reference,
+                                      const std::size_t count)
+{
+    myPassStarted = true;
+    input.resize(count, myInputCount);
+    reference.resize(count, myOutputCount);
+    std::size_t readCount{};
+
+    while (readCount < count)
+    {
+        while ((myWindowCount < myWindowInput.rowCount()) && fillWindow());
+        if (myWindowCount == 0U) { break; }
+
+        // Draws a random set from the window and fills the gap with the last set.
+        const auto i{utils::random::getNumber<std::size_t>(0U, myWindowCount - 1U)};
+        const auto last{--myWindowCount};
+        std::copy(myWindowInput.row(i).begin(), myWindowInput.row(i).end(),
+                  input.row(readCount).begin());
+        std::copy(myWindowReference.row(i).begin(), myWindowReference.row(i).end(),
+                  reference.row(readCount).begin());
+        std::copy(myWindowInput.row(last).begin(), myWindowInput.row(last).end(),
+                  myWindowInput.row(i).begin());
+        std::copy(myWindowReference.row(last).begin(), myWindowReference.row(last).end(),
+                  myWindowReference.row(i).begin());
+        ++readCount;
+    }
+    if (readCount < count)
+    {
+        keepRows(input, readCount);
+        keepRows(reference, readCount);
+    }
+    return readCount;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void StreamingDataset<T>::rewind()
+{
+    if (!myPassStarted) { return; }
+    stopReader();
+    startReader();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void StreamingDataset<T>::startReader()
+{
+    for (auto& chunk : myChunks)
+    {
+        chunk.count  = 0U;
+        chunk.filled = false;
+    }
+    myStopping     = false;
+    myError        = nullptr;
+    myChunkIndex   = 0U;
+    myChunkRow     = 0U;
+    myHoldingChunk = false;
+    myEndOfPass    = false;
+    myPassStarted  = false;
+    myWindowCount  = 0U;
+    myReader       = std::thread{&StreamingDataset::readFile, this};
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void StreamingDataset<T>::stopReader()
+{
+    if (!myReader.joinable()) { return; }
+    {
+        std::lock_guard<std::mutex> lock{myMutex};
+        myStopping = true;
+    }
+    myCondition.notify_all();
+    myReader.join();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void StreamingDataset<T>::readFile()
+{
+    std::ifstream file{myPath, std::ios::binary};
+    std::size_t lineNumber{};
+
+    for (std::size_t index{}; ; index ^= 1U)
+    {
+        auto& chunk{myChunks[index]};
+        {
+            std::unique_lock<std::mutex> lock{myMutex};
+            myCondition.wait(lock, [this, &chunk] { return !chunk.filled || myStopping; });
+            if (myStopping) { return; }
+        }
+        std::exception_ptr error{};
+        std::size_t count{};
+
+        // The chunk is filled without holding the lock, since it is not consumed
+        // until it has been marked as filled.
+        try
+        {
+            if (file.is_open())
+            {
+                count = myFormat == DatasetFormat::Csv ? readCsv(file, chunk, lineNumber)
+                                                       : readBinary(file, chunk);
+            }
+            if (!file.is_open() || file.bad())
+            {
+                throw std::system_error(errno, std::generic_category(),
+                                        "Failed to read " + myPath);
+            }
+        }
+        catch (...) { error = std::current_exception(); }
+        {
+            std::lock_guard<std::mutex> lock{myMutex};
+            chunk.count  = count;
+            chunk.filled = true;
+            myError      = error;
+        }
+        myCondition.notify_all();
+        if ((count == 0U) || error) { return; }
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t StreamingDataset<T>::readCsv(std::istream& file, Chunk& chunk,
+                                         std::size_t& lineNumber)
+{
+    std::string line{};
+    std::vector<T> values(myInputCount + myOutputCount);
+    std::size_t count{};
+
+    while ((count < myChunkSize) && std::getline(file, line))
+    {
+        ++lineNumber;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) { continue; }
+
+        if (!parseCsvLine(line, values))
+        {
+            const auto first{line[line.find_first_not_of(" \t")]};
+            const auto numeric{std::string{"+-.0123456789"}.find(first) != std::string::npos};
+            if ((lineNumber == 1U) && !numeric) { continue; }
+            throw std::invalid_argument("Invalid training set on line " +
+                                        std::to_string(lineNumber) + " of " + myPath + "!");
+        }
+        std::copy(values.begin(), values.begin() + myInputCount,
+                  chunk.input.row(count).begin());
+        std::copy(values.begin() + myInputCount, values.end(),
+                  chunk.reference.row(count).begin());
+        ++count;
+    }
+    return count;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t StreamingDataset<T>::readBinary(std::istream& file, Chunk& chunk)
+{
+    const auto recordSize{myInputCount + myOutputCount};
+    std::vector<T> records(myChunkSize * recordSize);
+    file.read(reinterpret_cast<char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(T)));
+    const auto byteCount{static_cast<std::size_t>(file.gcount())};
+
+    if ((byteCount % (recordSize * sizeof(T))) != 0U)
+    {
+        throw std::invalid_argument("Truncated training set at the end of " + myPath + "!");
+    }
+    const auto count{byteCount / (recordSize * sizeof(T))};
+
+    for (std::size_t i{}; i < count; ++i)
+    {
+        const auto* const record{records.data() + i * recordSize};
+        std::copy(record, record + myInputCount, chunk.input.row(i).begin());
+        std::copy(record + myInputCount, record + recordSize, chunk.reference.row(i).begin());
+    }
+    return count;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+bool StreamingDataset<T>::fillWindow()
+{
+    while (!myHoldingChunk || (myChunkRow == myChunks[myChunkIndex].count))
+    {
+        if (myEndOfPass) { return false; }
+        std::unique_lock<std::mutex> lock{myMutex};
+
+        // Hands the consumed chunk back to the reader before waiting for the next.
+        if (myHoldingChunk)
+        {
+            myChunks[myChunkIndex].filled = false;
+            myChunkIndex ^= 1U;
+            myCondition.notify_all();
+        }
+        myCondition.wait(lock, [this] { return myChunks[myChunkIndex].filled; });
+        myHoldingChunk = true;
+        myChunkRow     = 0U;
+
+        if (myChunks[myChunkIndex].count == 0U)
+        {
+            myEndOfPass = true;
+            if (myError) { std::rethrow_exception(myError); }
+            return false;
+        }
+    }
+    const auto& chunk{myChunks[myChunkIndex]};
+    std::copy(chunk.input.row(myChunkRow).begin(), chunk.input.row(myChunkRow).end(),
+              myWindowInput.row(myWindowCount).begin());
+    std::copy(chunk.reference.row(myChunkRow).begin(), chunk.reference.row(myChunkRow).end(),
+              myWindowReference.row(myWindowCount).begin());
+    ++myChunkRow;
+    ++myWindowCount;
+    return true;
+}
+
+template class StreamingDataset<float>;
+template class StreamingDataset<double>;
+
+} // namespace ml
@@ -0,0 +1,200 @@
+/*******************************************************************************
+ * @brief Tests of the accuracy tiers of the hyperbolic tangent kernels.
+ ******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "act_func.h"
+#include "instruction_set.h"
+#include "kernels.h"
+
+namespace
+{
+
+/*******************************************************************************
+ * @brief Structure holding an accuracy tier and its documented maximum
+ *        absolute error compared to std::tanh.
+ ******************************************************************************/
+struct Tier
+{
+    ml::TanhPrecision precision; // The accuracy tier.
+    const char* name;            // The name of the tier.
+    double maxError;             // The documented maximum absolute error.
+};
+
+/*******************************************************************************
+ * @brief The tiers to test.
+ ******************************************************************************/
+constexpr Tier Tiers[]{{ml::TanhPrecision::Exact, "exact", 0.0},
+                       {ml::TanhPrecision::High, "high", 4e-7},
+                       {ml::TanhPrecision::Low, "low", 1e-4}};
+
+/*******************************************************************************
+ * @brief The number of failed checks.
+ ******************************************************************************/
+std::size_t failureCount{};
+
+// -----------------------------------------------------------------------------
+void check(const bool condition, const std::string& description)
+{
+    if (!condition)
+    {
+        std::cerr << "FAILED: " << description << "\n";
+        ++failureCount;
+    }
+}
+
+/*******************************************************************************
+ * @brief Provides inputs covering [-20, 20] densely, which is the range the
+ *        error bounds are documented for, points around both clamps, and
+ *        tails up to the largest finite number. The count is odd so that the
+ *        vectorized kernels run their scalar remainder loops as well.
+ *
+ * @tparam T The floating-point type of the inputs.
+ *
+ * @return Vector holding the inputs.
+ ******************************************************************************/
+template <typename T>
+std::vector<T> inputs()
+{
+    std::vector<T> input{};
+
+    for (int i{-200000}; i <= 200000; ++i) { input.push_back(static_cast<T>(i * 1e-4)); }
+    for (const T tail : {T{7.9}, T{7.90531110763549805}, T{7.91}, T{4.96}, T{4.97}, T{4.98},
+                         T{1e3}, T{1e30}, std::numeric_limits<T>::max()})
+    {
+        input.push_back(tail);
+        input.push_back(-tail);
+    }
+    return input;
+}
+
+/*******************************************************************************
+ * @brief Checks each tier for one floating-point type with the currently
+ *        selected instruction set.
+ *
+ * @tparam T The floating-point type to check.
+ *
+ * @param instructionSet The name of the selected instruction set.
+ * @param typeName       The name of the floating-point type.
+ ******************************************************************************/
+template <typename T>
+void checkTiers(const std::string& instructionSet, const std::string& typeName)
+{
+    const auto input{inputs<T>()};
+    std::vector<T> output(input.size());
+
+    // The result is rounded to T, which adds up to one unit in the last place.
+    const auto rounding{static_cast<double>(std::numeric_limits<T>::epsilon())};
+
+    for (const auto& tier : Tiers)
+    {
+        const auto prefix{instructionSet + " " + typeName + " " + tier.name + ": "};
+        ml::kernels::tanh(input.data(), output.data(), input.size(), tier.precision);
+        double maxError{};
+        bool bounded{true};
+
+        for (std::size_t i{}; i < input.size(); ++i)
+        {
+            const auto reference{std::tanh(static_cast<double>(input[i]))};
+            maxError = std::max(maxError, std::abs(static_cast<double>(output[i]) - reference));
+            bounded  = bounded && (std::abs(output[i]) <= T{1});
+        }
+        const auto bound{tier.maxError + rounding};
+        check(maxError <= bound,
+              prefix + "max error " + std::to_string(maxError) + " exceeds the bound");
+        check(bounded, prefix + "output outside [-1, 1]");
+
+        // Special values are checked at several offsets in a longer sequence, so
+        // that they pass through both the vectorized and the remainder loops.
+        // Infinite inputs are clamped, so the result is within the bound of +-1.
+        constexpr auto infinity{std::numeric_limits<T>::infinity()};
+        const std::vector<T> special{std::numeric_limits<T>::quiet_NaN(), infinity, -infinity};
+
+        for (const std::size_t offset : {0U, 5U, 17U})
+        {
+            std::vector<T> values(offset + special.size() + 3U, T{0.5});
+            std::copy(special.begin(), special.end(), values.begin() + offset);
+            ml::kernels::tanh(values.data(), values.data(), values.size(), tier.precision);
+
+            const auto at{" at offset " + std::to_string(offset)};
+            check(std::isnan(values[offset]), prefix + "tanh(NaN) is not NaN" + at);
+            check(std::abs(values[offset + 1U] - 1.0) <= bound, prefix + "tanh(inf) is not 1" + at);
+            check(std::abs(values[offset + 2U] + 1.0) <= bound, prefix + "tanh(-inf) is not -1" + at);
+        }
+    }
+}
+
+/*******************************************************************************
+ * @brief Checks the tanh gradient kernel against 1 - y^2 for one floating-point
+ *        type with the currently selected instruction set.
+ *
+ * @tparam T The floating-point type to check.
+ *
+ * @param instructionSet The name of the selected instruction set.
+ * @param typeName       The name of the floating-point type.
+ ******************************************************************************/
+template <typename T>
+void checkGradient(const std::string& instructionSet, const std::string& typeName)
+{
+    const auto input{inputs<T>()};
+    std::vector<T> output(input.size());
+    ml::kernels::tanh(input.data(), output.data(), input.size(), ml::TanhPrecision::High);
+    std::vector<T> gradient(output.size(), T{2});
+    ml::kernels::tanhGradient(output.data(), gradient.data(), output.size());
+
+    // Fused multiply-add rounds once instead of twice, which adds up to one unit.
+    const auto bound{4.0 * static_cast<double>(std::numeric_limits<T>::epsilon())};
+    double maxError{};
+
+    for (std::size_t i{}; i < output.size(); ++i)
+    {
+        const auto value{static_cast<double>(output[i])};
+        const auto reference{2.0 * (1.0 - value * value)};
+        maxError = std::max(maxError, std::abs(static_cast<double>(gradient[i]) - reference));
+    }
+    check(maxError <= bound, instructionSet + " " + typeName + ": tanh gradient error " + 
+                             std::to_string(maxError) + " exceeds the bound");
+}
+
+} // namespace
+
+/*******************************************************************************
+ * @brief Checks that the high and low accuracy tiers of the hyperbolic
+ *        tangent stay within their documented maximum absolute errors of
+ *        std::tanh, that NaN and infinite inputs are handled and that the
+ *        gradient kernel matches 1 - y^2, on every instruction set supported
+ *        by the CPU.
+ *
+ * @return Success code 0 if every check passed, otherwise 1.
+ ******************************************************************************/
+int main()
+{
+    const auto supported{ml::kernels::supportedInstructionSet()};
+
+    for (auto i{static_cast<unsigned>(ml::InstructionSet::Scalar)};
+         i <= static_cast<unsigned>(supported); ++i)
+    {
+        const auto instructionSet{static_cast<ml::InstructionSet>(i)};
+        const std::string name{ml::kernels::instructionSetName(instructionSet)};
+        ml::kernels::selectInstructionSet(instructionSet);
+        checkTiers<double>(name, "double");
+        checkTiers<float>(name, "float");
+        checkGradient<double>(name, "double");
+        checkGradient<float>(name, "float");
+        std::cout << "Checked tanh on " << name << "\n";
+    }
+    ml::kernels::selectInstructionSet(supported);
+
+    if (failureCount > 0U)
+    {
+        std::cerr << failureCount << " check(s) failed!\n";
+        return 1;
+    }
+    std::cout << "All tanh checks passed.\n";
+    return 0;
+}
@@ -0,0 +1,226 @@
+/*******************************************************************************
+ * @brief Implementation details of the utils::ThreadPool class.
+ ******************************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "thread_pool.h"
+
+namespace
+{
+
+/*******************************************************************************
+ * @brief The thread pool owning the calling thread (if any).
+ ******************************************************************************/
+thread_local const utils::ThreadPool* currentPool{nullptr};
+
+/*******************************************************************************
+ * @brief The index of the queue owned by the calling thread.
+ ******************************************************************************/
+thread_local std::size_t currentQueue{};
+
+// -----------------------------------------------------------------------------
+std::size_t defaultThreadCount()
+{
+    const auto* const value{std::getenv("ML_THREAD_COUNT")};
+
+    if (value != nullptr)
+    {
+        char* end{};
+        const auto threadCount{std::strtoul(value, &end, 10)};
+
+        if ((end == value) || (*end != '\0') || (threadCount == 0U))
+        {
+            throw std::invalid_argument("Invalid thread count " + std::string{value} +
+                                        " in ML_THREAD_COUNT!");
+        }
+        return threadCount;
+    }
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1U);
+}
+
+} // namespace
+
+namespace utils
+{
+
+// -----------------------------------------------------------------------------
+ThreadPool::TaskGroup::TaskGroup(ThreadPool& pool) noexcept
+    : myPool{pool}
+    , myMutex{}
+    , myCondition{}
+    , myPendingCount{}
+    , myError{} {}
+
+// -----------------------------------------------------------------------------
+ThreadPool::TaskGroup::~TaskGroup()
+{
+    try { wait(); }
+    catch (...) {}
+}
+
+// -----------------------------------------------------------------------------
+void ThreadPool::TaskGroup::wait()
+{
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock{myMutex};
+            if (myPendingCount == 0U) { break; }
+        }
+
+        // Once no task is left to run, the remaining tasks of the group are
+        // running on other threads, which push any nested tasks to their own
+        // queues and run them themselves. The thread thereby sleeps until the
+        // last task of the group has finished.
+        if (!myPool.runPendingTask())
+        {
+            std::unique_lock<std::mutex> lock{myMutex};
+            myCondition.wait(lock, [this] { return myPendingCount == 0U; });
+        }
+    }
+    if (myError) { std::rethrow_exception(std::exchange(myError, nullptr)); }
+}
+
+// -----------------------------------------------------------------------------
+void ThreadPool::TaskGroup::finish(std::exception_ptr error)
+{
+    // The last task notifies the group while locked, since the waiting thread may
+    // delete the group as soon as it observes that no task is pending.
+    std::lock_guard<std::mutex> lock{myMutex};
+    if (error && !myError) { myError = error; }
+    if (--myPendingCount == 0U) { myCondition.notify_all(); }
+}
+
+// -----------------------------------------------------------------------------
+ThreadPool::ThreadPool(const std::size_t threadCount)
+    : myQueues{}
+    , myThreads{}
+    , myMutex{}
+    , myCondition{}
+    , myQueuedCount{}
+    , myStopping{false}
+{
+    if (threadCount == 0U)
+    {
+        throw std::invalid_argument("Invalid thread count 0!");
+    }
+    for (std::size_t i{}; i < threadCount; ++i)
+    {
+        myQueues.push_back(std::make_unique<Queue>());
+        (*myQueues.back()).chunks.resize(QueueCapacity);
+    }
+    myThreads.reserve(threadCount - 1U);
+
+    for (std::size_t i{1U}; i < threadCount; ++i)
+    {
+        myThreads.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+// -----------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{myMutex};
+        myStopping = true;
+    }
+    myCondition.notify_all();
+    for (auto& thread : myThreads) { thread.join(); }
+}
+
+// -----------------------------------------------------------------------------
+ThreadPool& ThreadPool::instance()
+{
+    static ThreadPool pool{defaultThreadCount()};
+    return pool;
+}
+
+// -----------------------------------------------------------------------------
+std::size_t ThreadPool::threadCount() const noexcept { return myQueues.size(); }
+
+// -----------------------------------------------------------------------------
+bool ThreadPool::push(const Chunk& chunk)
+{
+    auto& queue{*myQueues[queueIndex()]};
+    {
+        std::lock_guard<std::mutex> lock{queue.mutex};
+        if (queue.count == queue.chunks.size()) { return false; }
+        queue.chunks[(queue.front + queue.count) % queue.chunks.size()] = chunk;
+        ++queue.count;
+    }
+    {
+        std::lock_guard<std::mutex> lock{myMutex};
+        ++myQueuedCount;
+    }
+    myCondition.notify_one();
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+void ThreadPool::runChunk(const Chunk& chunk)
+{
+    std::exception_ptr error{};
+    try { chunk.invoke(chunk.task, chunk.first, chunk.last); }
+    catch (...) { error = std::current_exception(); }
+    (*chunk.group).finish(error);
+}
+
+// -----------------------------------------------------------------------------
+bool ThreadPool::runPendingTask()
+{
+    const auto own{queueIndex()};
+    Chunk chunk{};
+    bool found{false};
+
+    // The own queue is popped from the back, while other queues are stolen from
+    // at the front, where the oldest and typically largest tasks are.
+    for (std::size_t i{}; (i < myQueues.size()) && !found; ++i)
+    {
+        auto& queue{*myQueues[(own + i) % myQueues.size()]};
+        std::lock_guard<std::mutex> lock{queue.mutex};
+        if (queue.count == 0U) { continue; }
+
+        if (i == 0U)
+        {
+            chunk = queue.chunks[(queue.front + queue.count - 1U) % queue.chunks.size()];
+        }
+        else
+        {
+            chunk       = queue.chunks[queue.front];
+            queue.front = (queue.front + 1U) % queue.chunks.size();
+        }
+        --queue.count;
+        found = true;
+    }
+    if (!found) { return false; }
+    --myQueuedCount;
+    runChunk(chunk);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+void ThreadPool::work(const std::size_t queue)
+{
+    currentPool  = this;
+    currentQueue = queue;
+
+    while (true)
+    {
+        if (runPendingTask()) { continue; }
+        std::unique_lock<std::mutex> lock{myMutex};
+        myCondition.wait(lock, [this] { return myStopping || (myQueuedCount > 0U); });
+        if (myStopping && (myQueuedCount == 0U)) { return; }
+    }
+}
+
+// -----------------------------------------------------------------------------
+std::size_t ThreadPool::queueIndex() const noexcept
+{
+    return currentPool == this ? currentQueue : 0U;
+}
+
+} // namespace utils
@@ -0,0 +1,225 @@
+/*******************************************************************************
+ * @brief Implementation details of the ml::TrainingData class.
+ ******************************************************************************/
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#include "mapped_file.h"
+#include "streaming_dataset.h"
+#include "training_data.h"
+
+namespace
+{
+
+/*******************************************************************************
+ * @brief The number of training sets read per chunk when converting files.
+ ******************************************************************************/
+constexpr std::size_t ConversionChunkSize{4096U};
+
+// -----------------------------------------------------------------------------
+void checkTrainingData(const bool valid, const char* message)
+{
+    if (!valid)
+    {
+        throw std::invalid_argument(std::string{"Invalid training data file: "} + message);
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void checkBlock(const std::uint64_t offset, const std::uint64_t rowCount,
+                const std::uint64_t columnCount, const std::uint64_t fileSize)
+{
+    checkTrainingData(columnCount <= ml::Matrix<T>::MaxColumnCount, "too many columns!");
+    const auto stride{ml::Matrix<T>::strideFor(columnCount)};
+    checkTrainingData(stride != 0U, "invalid stride!");
+    checkTrainingData((offset % ml::Matrix<T>::Alignment) == 0U, "misaligned block!");
+    checkTrainingData((offset <= fileSize) &&
+                      (rowCount <= (fileSize - offset) / sizeof(T) / stride),
+                      "block exceeds the file!");
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void writeRows(std::ostream& file, const ml::Matrix<T>& rows)
+{
+    file.write(reinterpret_cast<const char*>(rows.data()),
+               static_cast<std::streamsize>(rows.rowCount() * rows.stride() * sizeof(T)));
+}
+
+// -----------------------------------------------------------------------------
+std::uint64_t alignBlock(const std::uint64_t offset, const std::size_t alignment)
+{
+    return (offset + alignment - 1U) / alignment * alignment;
+}
+
+} // namespace
+
+namespace ml
+{
+
+// -----------------------------------------------------------------------------
+template <typename T>
+TrainingData<T>::TrainingData() noexcept
+    : myStorage{}
+    , myInput{}
+    , myReference{} {}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+TrainingData<T>::TrainingData(const std::vector<std::vector<T>>& input,
+                              const std::vector<std::vector<T>>& output)
+    : TrainingData{}
+{
+    if (input.size() != output.size())
+    {
+        throw std::invalid_argument("Mismatching training sets!");
+    }
+    if (input.empty()) { return; }
+    myInput.resize(input.size(), input.front().size());
+    myReference.resize(output.size(), output.front().size());
+
+    for (std::size_t i{}; i < input.size(); ++i)
+    {
+        if ((input[i].size() != inputCount()) || (output[i].size() != outputCount()))
+        {
+            throw std::invalid_argument("Training sets of different shapes!");
+        }
+        std::copy(input[i].begin(), input[i].end(), myInput.row(i).begin());
+        std::copy(output[i].begin(), output[i].end(), myReference.row(i).begin());
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+TrainingData<T>::TrainingData(const std::string& path)
+    : TrainingData{}
+{
+    const auto file{mapFile(path, sizeof(Header))};
+    Header header{};
+    std::memcpy(&header, file.data, sizeof(header));
+
+    checkTrainingData(std::equal(std::begin(Magic), std::end(Magic), header.magic),
+                      "unknown signature!");
+    checkTrainingData(header.version == Version, "unsupported version!");
+    checkTrainingData(header.scalarType == scalarType<T>(), "mismatching scalar type!");
+    checkTrainingData(header.fileSize == file.size, "truncated file!");
+    checkTrainingData((header.inputCount > 0U) && (header.outputCount > 0U),
+                      "training sets without input or output!");
+    checkBlock<T>(header.inputOffset, header.setCount, header.inputCount, file.size);
+    checkBlock<T>(header.referenceOffset, header.setCount, header.outputCount, file.size);
+
+    myStorage   = file.storage;
+    myInput     = Matrix<T>{reinterpret_cast<T*>(file.data + header.inputOffset),
+                            header.setCount, header.inputCount};
+    myReference = Matrix<T>{reinterpret_cast<T*>(file.data + header.referenceOffset),
+                            header.setCount, header.outputCount};
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t TrainingData<T>::convertCsv(const std::string& csvPath, const std::string& path,
+                                        const std::size_t inputCount,
+                                        const std::size_t outputCount)
+{
+    StreamingDataset<T> dataset{csvPath, inputCount, outputCount, DatasetFormat::Csv,
+                                ConversionChunkSize, 1U};
+
+    // The input block is written directly after the header, while the reference
+    // block is buffered in a temporary file until the number of sets is known.
+    const auto temporaryPath{path + ".tmp"};
+    const auto referencePath{path + ".reference.tmp"};
+    std::ofstream file{temporaryPath, std::ios::binary | std::ios::trunc};
+    std::fstream references{referencePath, std::ios::binary | std::ios::trunc |
+                                           std::ios::in | std::ios::out};
+    if (!file || !references)
+    {
+        const auto error{errno};
+        std::remove(temporaryPath.c_str());
+        std::remove(referencePath.c_str());
+        throw std::system_error(error, std::generic_category(), "Failed to create " + path);
+    }
+    Header header{};
+    std::copy(std::begin(Magic), std::end(Magic), header.magic);
+    header.version     = Version;
+    header.scalarType  = scalarType<T>();
+    header.inputCount  = inputCount;
+    header.outputCount = outputCount;
+    header.inputOffset = alignBlock(sizeof(header), Matrix<T>::Alignment);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(std::string(header.inputOffset - sizeof(header), '\0').data(),
+               static_cast<std::streamsize>(header.inputOffset - sizeof(header)));
+
+    Matrix<T> input{};
+    Matrix<T> reference{};
+
+    try
+    {
+        while (dataset.read(input, reference, ConversionChunkSize) > 0U)
+        {
+            writeRows(file, input);
+            writeRows(references, reference);
+            header.setCount += input.rowCount();
+        }
+    }
+    catch (...)
+    {
+        std::remove(temporaryPath.c_str());
+        std::remove(referencePath.c_str());
+        throw;
+    }
+    header.referenceOffset = static_cast<std::uint64_t>(file.tellp());
+    references.seekg(0);
+    if (header.setCount > 0U) { file << references.rdbuf(); }
+    header.fileSize = static_cast<std::uint64_t>(file.tellp());
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+    references.close();
+    std::remove(referencePath.c_str());
+
+    if (!file || (std::rename(temporaryPath.c_str(), path.c_str()) != 0))
+    {
+        const auto error{errno};
+        std::remove(temporaryPath.c_str());
+        throw std::system_error(error, std::generic_category(), "Failed to write " + path);
+    }
+    return header.setCount;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t TrainingData<T>::size() const noexcept { return myInput.rowCount(); }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+bool TrainingData<T>::empty() const noexcept { return size() == 0U; }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t TrainingData<T>::inputCount() const noexcept { return myInput.columnCount(); }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::size_t TrainingData<T>::outputCount() const noexcept
+{
+    return myReference.columnCount();
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+const Matrix<T>& TrainingData<T>::input() const noexcept { return myInput; }
+
+// -----------------------------------------------------------------------------
+template <typename T>
+const Matrix<T>& TrainingData<T>::reference() const noexcept { return myReference; }
+
+template class TrainingData<float>;
+template class TrainingData<double>;
+
+} // namespace ml